@@ -0,0 +1,228 @@
+#include "dataframe/dataframe.h"
+#include <chrono>
+#include <random>
+
+/*
+*	standalone CSV tokenizer benchmark, not part of the project build:
+*		g++ -std=c++17 -O2 -pthread bench_csv.cpp -o bench_csv
+*		cl /std:c++17 /O2 bench_csv.cpp
+*	times c_dataframe::_tokenize_csv with each n_simd scanner against the getline + _parse_csv_line loop from_csv used before
+*	it, on one thread over a generated numeric CSV held in memory, and reports GB/s per core. the tokenizer callbacks do
+*	almost no work, so a second table loads the same csv from a temporary file through from_csv on the whole thread pool
+*/
+class c_csv_bench
+{
+public:
+
+	struct s_result
+	{
+		size_t records = 0;
+		size_t fields = 0;
+		size_t bytes = 0;
+	};
+
+	/*
+	*	rows of cols comma separated doubles and integers, '\n' terminated
+	*/
+	static std::string make_csv(size_t rows, size_t cols)
+	{
+		std::mt19937_64 rng(42);
+		std::uniform_real_distribution<double> real(-1e6, 1e6);
+		std::uniform_int_distribution<int64_t> integer(-1000000, 1000000);
+
+		std::string csv;
+		csv.reserve(rows * cols * 16);
+
+		char buf[64];
+		for (size_t r = 0; r < rows; ++r)
+		{
+			for (size_t c = 0; c < cols; ++c)
+			{
+				auto [p, ec] = c & 1 ? std::to_chars(buf, buf + sizeof(buf), integer(rng)) : std::to_chars(buf, buf + sizeof(buf), real(rng));
+				csv.append(buf, p);
+				csv.push_back(c + 1 < cols ? ',' : '\n');
+			}
+		}
+
+		return csv;
+	}
+
+	/*
+	*	the record parser from_csv used before _tokenize_csv, unchanged
+	*/
+	static std::vector<std::string> _parse_csv_line(const std::string& line)
+	{
+		std::vector<std::string> fields;
+
+		std::string cur;
+		cur.reserve(line.size());
+
+		bool in_quotes = false;
+		for (size_t i = 0; i < line.size(); ++i)
+		{
+			char c = line[i];
+			if (in_quotes)
+			{
+				if (c == '"') {
+					if (i + 1 < line.size() && line[i + 1] == '"') { cur.push_back('"'); ++i; }
+					else { in_quotes = false; }
+				}
+				else cur.push_back(c);
+			}
+			else
+			{
+				if (c == ',') { fields.emplace_back(std::move(cur)); cur.clear(); }
+				else if (c == '"') { in_quotes = true; }
+				else { cur.push_back(c); }
+			}
+		}
+
+		fields.emplace_back(std::move(cur));
+
+		return fields;
+	}
+
+	/*
+	*	the previous from_csv read loop, over the csv in memory instead of an ifstream
+	*/
+	static s_result parse_lines(const std::string& csv)
+	{
+		s_result r;
+		std::istringstream file(csv);
+
+		std::string line;
+		while (std::getline(file, line))
+		{
+			std::vector<std::string> fields = _parse_csv_line(line);
+			r.records++;
+			r.fields += fields.size();
+			for (const auto& field : fields) { r.bytes += field.size(); }
+		}
+
+		return r;
+	}
+
+	/*
+	*	the shipped tokenizer with scan pinned as the n_simd scanner; fields arrive as the views from_csv parses numbers from
+	*/
+	static s_result tokenize(const std::string& csv, n_simd::csv_scanner_t scan)
+	{
+		const n_simd::csv_scanner_t previous = n_simd::csv_scanner();
+		n_simd::csv_scanner() = scan;
+
+		s_result r;
+		std::string scratch;
+		c_dataframe::_tokenize_csv(csv.data(), csv.data() + csv.size(), scratch,
+			[&](size_t, std::string_view field) {
+				r.fields++;
+				r.bytes += field.size();
+			},
+			[&]() {
+				r.records++;
+				return true;
+			});
+
+		n_simd::csv_scanner() = previous;
+		return r;
+	}
+
+	/*
+	*	from_csv of the csv written to path with scan pinned, tokenizing plus number parsing into the columns
+	*/
+	static s_result load(const std::string& path, n_simd::csv_scanner_t scan)
+	{
+		const n_simd::csv_scanner_t previous = n_simd::csv_scanner();
+		n_simd::csv_scanner() = scan;
+
+		s_result r;
+		c_dataframe df(path, false);
+		r.records = df.shape().first;
+		r.fields = df.shape().first * df.shape().second;
+
+		n_simd::csv_scanner() = previous;
+		return r;
+	}
+
+	/*
+	*	best of runs, in GB/s
+	*/
+	template<class fn_t>
+	static double measure(const std::string& csv, size_t runs, s_result& result, fn_t&& fn)
+	{
+		double best = std::numeric_limits<double>::infinity();
+		for (size_t i = 0; i < runs; ++i)
+		{
+			const auto t0 = std::chrono::steady_clock::now();
+			result = fn(csv);
+			const auto t1 = std::chrono::steady_clock::now();
+			best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+		}
+
+		return static_cast<double>(csv.size()) / best / 1e9;
+	}
+};
+
+int main(int argc, char** argv)
+{
+	const size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+	const size_t cols = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+	const size_t runs = 5;
+
+	const std::string csv = c_csv_bench::make_csv(rows, cols);
+	std::cout << "csv: " << rows << " rows x " << cols << " columns, " << std::fixed << std::setprecision(1) << static_cast<double>(csv.size()) / 1e6 << " MB, best of " << runs << " runs\n\n";
+
+	struct s_case
+	{
+		const char* name;
+		std::function<c_csv_bench::s_result(const std::string&)> fn;
+	};
+
+	std::vector<std::pair<const char*, n_simd::csv_scanner_t>> scanners;
+#ifdef SIMD_X86
+	if (n_simd::has_avx2()) { scanners.emplace_back("avx2", n_simd::scan_csv_avx2); }
+	scanners.emplace_back("sse2", n_simd::scan_csv_sse2);
+#endif
+	scanners.emplace_back("scalar", n_simd::scan_csv_scalar);
+
+	const std::string path = "bench_csv.tmp.csv";
+	{
+		std::ofstream file(path, std::ios::out | std::ios::binary);
+		file.write(csv.data(), static_cast<std::streamsize>(csv.size()));
+	}
+
+	std::vector<s_case> tokenize, load;
+	tokenize.push_back({ "_parse_csv_line", c_csv_bench::parse_lines });
+	for (const auto& [name, scan] : scanners)
+	{
+		tokenize.push_back({ name, [scan = scan](const std::string& s) { return c_csv_bench::tokenize(s, scan); } });
+		load.push_back({ name, [&path, scan = scan](const std::string&) { return c_csv_bench::load(path, scan); } });
+	}
+
+	auto report = [&](const std::vector<s_case>& cases) {
+		double baseline = 0.0;
+		c_csv_bench::s_result expected;
+		for (size_t i = 0; i < cases.size(); ++i)
+		{
+			c_csv_bench::s_result result;
+			const double gbps = c_csv_bench::measure(csv, runs, result, cases[i].fn);
+			if (!i)
+			{
+				baseline = gbps;
+				expected = result;
+			}
+
+			const bool match = result.records == expected.records && result.fields == expected.fields && result.bytes == expected.bytes;
+			std::cout << std::left << std::setw(16) << cases[i].name << std::right << std::setprecision(2) << std::setw(8) << gbps << " GB/s  "
+				<< std::setw(6) << gbps / baseline << "x  " << result.fields << " fields" << (match ? "" : "  MISMATCH") << "\n";
+		}
+		};
+
+	std::cout << "tokenize, one thread\n";
+	report(tokenize);
+
+	std::cout << "\nfrom_csv, thread pool of " << c_thread_pool::get().size() << "\n";
+	report(load);
+
+	std::remove(path.c_str());
+	return 0;
+}
@@ -1,9 +1,9 @@
 #pragma once
 
 /*
-* 
+*
 *		MADE BY NBQ
-* 
+*
 */
 
 #define NOMINMAX
@@ -14,12 +14,51 @@
 #include <variant>
 #include <unordered_map>
 #include <map>
+#include <vector>
 #include <optional>
 #include <charconv>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <atomic>
+#include <exception>
+#include <cstring>
+#include <memory>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX512
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 //#define _USE_ORDERED_COLUMNS
 
@@ -31,6 +70,24 @@
 
 using value_t = std::variant<double, std::string>;
 
+enum class e_dtype : uint8_t
+{
+	f64,
+	i64,
+	boolean,
+	str
+};
+
+enum class e_compare : uint8_t
+{
+	eq,
+	ne,
+	lt,
+	le,
+	gt,
+	ge
+};
+
 namespace n_math
 {
 	double relative_change(double x, double y)
@@ -77,1547 +134,8107 @@ namespace n_math
 		for (size_t i = 1; i < x.size(); ++i) { dx[i - 1] = x[i] - x[i - 1]; }
 		return dx;
 	}
-}
 
-class c_logger
-{
-private:
+	/*
+	*	count, sum, min, max and the central moment sums m2..m4 of the non-NaN values added so far. two accumulators merge
+	*	exactly (Pebay's pairwise update), so blocks and threads can be reduced independently and combined in any fixed order
+	*/
+	struct s_moments
+	{
+		size_t n = 0;
+		double sum = 0.0;
+		double mean = 0.0;
+		double m2 = 0.0;
+		double m3 = 0.0;
+		double m4 = 0.0;
+		double min = std::numeric_limits<double>::infinity();
+		double max = -std::numeric_limits<double>::infinity();
 
-	c_logger() {}
+		static constexpr size_t _block = 1024;
 
-	~c_logger() {}
+		void merge(const s_moments& o)
+		{
+			if (!o.n) { return; }
+			if (!this->n) { *this = o; return; }
+
+			const double na = static_cast<double>(this->n);
+			const double nb = static_cast<double>(o.n);
+			const double nt = na + nb;
+			const double delta = o.mean - this->mean;
+			const double d_n = delta / nt;
+			const double d_n2 = d_n * d_n;
+
+			this->m4 += o.m4 + delta * d_n * d_n2 * na * nb * (na * na - na * nb + nb * nb)
+				+ 6.0 * d_n2 * (na * na * o.m2 + nb * nb * this->m2) + 4.0 * d_n * (na * o.m3 - nb * this->m3);
+			this->m3 += o.m3 + delta * d_n2 * na * nb * (na - nb) + 3.0 * d_n * (na * o.m2 - nb * this->m2);
+			this->m2 += o.m2 + delta * d_n * na * nb;
+			this->mean += d_n * nb;
+			this->n += o.n;
+			this->sum += o.sum;
+			this->min = std::min(this->min, o.min);
+			this->max = std::max(this->max, o.max);
+		}
 
-	c_logger(const c_logger&) = delete;
+		/*
+		*	values are taken in blocks small enough to stay in L1: one pass for the block sum, a second for the moments
+		*	around the block mean, then the block is merged in
+		*/
+		template<class t>
+		void add(const t* p, size_t k)
+		{
+			for (size_t b = 0; b < k; b += _block)
+			{
+				const size_t e = std::min(k, b + _block);
 
-	c_logger& operator=(const c_logger&) = delete;
+				s_moments block;
+				for (size_t i = b; i < e; ++i)
+				{
+					const double d = static_cast<double>(p[i]);
+					if (std::isnan(d)) { continue; }
 
-public:
+					++block.n;
+					block.sum += d;
+					if (d < block.min) { block.min = d; }
+					if (d > block.max) { block.max = d; }
+				}
+				if (!block.n) { continue; }
 
-	static c_logger& get() noexcept
-	{
-		static c_logger instance;
-		return instance;
-	}
+				block.mean = block.sum / static_cast<double>(block.n);
+				for (size_t i = b; i < e; ++i)
+				{
+					const double d = static_cast<double>(p[i]);
+					if (std::isnan(d)) { continue; }
+
+					const double x = d - block.mean;
+					const double x2 = x * x;
+					block.m2 += x2;
+					block.m3 += x2 * x;
+					block.m4 += x2 * x2;
+				}
 
-	bool log(const std::string& msg, unsigned short color) noexcept
-	{
-		if (msg.empty()) { return false; }
-		SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
-		std::cout << msg;
-		SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), LOG_CLR_NORMAL);
-		return true;
-	}
+				this->merge(block);
+			}
+		}
+	};
 
-	bool log_formatted(const std::string& msg, unsigned short color, int width) noexcept
+	/*
+	*	co-moment sum c of the pairs where both values are set, plus the sums of every set value of each side (cov centers
+	*	each column on its own sum / length). merges like s_moments, with Chan's pairwise update
+	*/
+	struct s_comoments
 	{
-		if (msg.empty()) { return false; }
-		SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
-		std::cout << std::setw(width) << std::left << msg;
-		SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), LOG_CLR_NORMAL);
-		return true;
-	}
-};
-
-class c_dataframe
-{
-private:
-
-#ifdef _USE_ORDERED_COLUMNS
-	std::map<std::string, std::vector<value_t>> m_data;
-#else
-	std::unordered_map<std::string, std::vector<value_t>> m_data;
-#endif
-	size_t m_rows = 0;
+		size_t n = 0;
+		double mean1 = 0.0;
+		double mean2 = 0.0;
+		double c = 0.0;
+		double sum1 = 0.0;
+		double sum2 = 0.0;
 
+		static constexpr size_t _block = 1024;
 
-	static bool _is_blank(std::string_view sv)
-	{
-		for (unsigned char c : sv)
+		void merge(const s_comoments& o)
 		{
-			if (!std::isspace(c)) { return false; }
+			this->sum1 += o.sum1;
+			this->sum2 += o.sum2;
+			if (!o.n) { return; }
+
+			const double na = static_cast<double>(this->n);
+			const double nb = static_cast<double>(o.n);
+			const double nt = na + nb;
+			const double d1 = o.mean1 - this->mean1;
+			const double d2 = o.mean2 - this->mean2;
+
+			this->c += o.c + d1 * d2 * na * nb / nt;
+			this->mean1 += d1 * nb / nt;
+			this->mean2 += d2 * nb / nt;
+			this->n += o.n;
 		}
-		return true;
-	}
 
-	static std::optional<double> _parse_double(std::string_view sv)
-	{
-		if (sv.empty()) { return std::nullopt; }
-
-		auto eq = [&](std::string_view t) {
-			if (sv.size() != t.size()) { return false; }
-			for (size_t i = 0; i < sv.size(); ++i)
+		template<class t1, class t2>
+		void add(const t1* p1, const t2* p2, size_t k)
+		{
+			for (size_t b = 0; b < k; b += _block)
 			{
-				if ((char)std::tolower((unsigned char)sv[i]) != t[i]) { return false; }
-			}
-			return true;
-			};
+				const size_t e = std::min(k, b + _block);
 
-		if (eq("nan")) { return std::numeric_limits<double>::quiet_NaN(); }
-		if (eq("inf") || eq("+inf")) { return std::numeric_limits<double>::infinity(); }
-		if (eq("-inf")) { return -std::numeric_limits<double>::infinity(); }
+				s_comoments block;
+				double s1 = 0.0;
+				double s2 = 0.0;
+				for (size_t i = b; i < e; ++i)
+				{
+					const double d1 = static_cast<double>(p1[i]);
+					const double d2 = static_cast<double>(p2[i]);
+					const bool set1 = !std::isnan(d1);
+					const bool set2 = !std::isnan(d2);
+
+					if (set1) { block.sum1 += d1; }
+					if (set2) { block.sum2 += d2; }
+					if (set1 && set2)
+					{
+						++block.n;
+						s1 += d1;
+						s2 += d2;
+					}
+				}
 
-		double v = 0.0;
-		auto* b = sv.data(); auto* e = b + sv.size();
-		auto [p, ec] = std::from_chars(b, e, v);
-		if (ec == std::errc() && p == e) { return v; }
+				if (block.n)
+				{
+					block.mean1 = s1 / static_cast<double>(block.n);
+					block.mean2 = s2 / static_cast<double>(block.n);
+					for (size_t i = b; i < e; ++i)
+					{
+						const double d1 = static_cast<double>(p1[i]);
+						const double d2 = static_cast<double>(p2[i]);
+						if (!std::isnan(d1) && !std::isnan(d2)) { block.c += (d1 - block.mean1) * (d2 - block.mean2); }
+					}
+				}
 
-		return std::nullopt;
-	}
+				this->merge(block);
+			}
+		}
+	};
+}
 
-	static std::string _value_to_string(const value_t& value)
+namespace n_simd
+{
+	/*
+	*	one bit per byte of a 64 byte block
+	*/
+	struct s_csv_masks
 	{
-		return std::visit([](auto&& val) -> std::string {
+		uint64_t quotes = 0;
+		uint64_t commas = 0;
+		uint64_t newlines = 0;
+	};
 
-			using t = std::decay_t<decltype(val)>;
-
-			if constexpr (std::is_same_v<t, std::string>)
-			{
-				return val;
-			}
-			else
-			{
-				std::ostringstream oss;
-				oss.imbue(std::locale::classic());
-				oss << val;
-				return oss.str();
-			}
-			}, value);
-	}
+	using csv_scanner_t = s_csv_masks(*)(const char*);
 
-	static value_t _to_value(const value_t& v)
+	inline unsigned ctz(uint64_t x)
 	{
-		return v;
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long i = 0;
+		_BitScanForward64(&i, x);
+		return static_cast<unsigned>(i);
+#elif defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+		unsigned i = 0;
+		while (!(x & 1)) { x >>= 1; ++i; }
+		return i;
+#endif
 	}
 
-	static value_t _to_value(value_t&& v)
+	inline unsigned msb(uint64_t x)
 	{
-		return std::move(v);
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long i = 0;
+		_BitScanReverse64(&i, x);
+		return static_cast<unsigned>(i);
+#elif defined(__GNUC__) || defined(__clang__)
+		return 63u - static_cast<unsigned>(__builtin_clzll(x));
+#else
+		unsigned i = 0;
+		while (x >>= 1) { ++i; }
+		return i;
+#endif
 	}
 
-	static value_t _to_value(double v)
+	inline unsigned popcount(uint64_t x)
 	{
-		return value_t{ v };
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned>(__builtin_popcountll(x));
+#else
+		x = x - ((x >> 1) & 0x5555555555555555ull);
+		x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+		x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+		return static_cast<unsigned>((x * 0x0101010101010101ull) >> 56);
+#endif
 	}
 
-	static value_t _to_value(size_t v)
+	/*
+	*	bit i is set when an odd number of bits at or below i are set, i.e. the byte is inside quotes
+	*/
+	inline uint64_t prefix_xor(uint64_t x)
 	{
-		return value_t{ static_cast<double>(v) };
+		x ^= x << 1;
+		x ^= x << 2;
+		x ^= x << 4;
+		x ^= x << 8;
+		x ^= x << 16;
+		x ^= x << 32;
+		return x;
 	}
 
-	static value_t _to_value(long long v)
+	/*
+	*	one bit per byte of the little-endian word w equal to the byte repeated in c, gathered into the low 8 bits
+	*/
+	inline uint64_t swar_eq(uint64_t w, uint64_t c)
 	{
-		return value_t{ static_cast<double>(v) };
+		const uint64_t x = w ^ c;
+		const uint64_t high = ~(((x & 0x7F7F7F7F7F7F7F7Full) + 0x7F7F7F7F7F7F7F7Full) | x) & 0x8080808080808080ull;
+		return ((high >> 7) * 0x0102040810204080ull) >> 56;
 	}
 
-	static value_t _to_value(int v)
+	/*
+	*	eight bytes per step with SWAR compares; byte at a time on big-endian targets
+	*/
+	inline s_csv_masks scan_csv_scalar(const char* p)
 	{
-		return value_t{ static_cast<double>(v) };
+		s_csv_masks m;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		for (unsigned i = 0; i < 64; ++i)
+		{
+			const uint64_t bit = uint64_t(1) << i;
+			if (p[i] == '"') { m.quotes |= bit; }
+			else if (p[i] == ',') { m.commas |= bit; }
+			else if (p[i] == '\n') { m.newlines |= bit; }
+		}
+#else
+		for (unsigned i = 0; i < 64; i += 8)
+		{
+			uint64_t w;
+			std::memcpy(&w, p + i, sizeof(w));
+			m.quotes |= swar_eq(w, 0x2222222222222222ull) << i;
+			m.commas |= swar_eq(w, 0x2C2C2C2C2C2C2C2Cull) << i;
+			m.newlines |= swar_eq(w, 0x0A0A0A0A0A0A0A0Aull) << i;
+		}
+#endif
+		return m;
 	}
 
-	static value_t _to_value(bool v)
+#ifdef SIMD_X86
+	inline s_csv_masks scan_csv_sse2(const char* p)
 	{
-		return value_t{ v ? 1.0 : 0.0 };
-	}
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i comma = _mm_set1_epi8(',');
+		const __m128i newline = _mm_set1_epi8('\n');
 
-	static value_t _to_value(const std::string& s)
-	{
-		return value_t{ s };
+		s_csv_masks m;
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16));
+			m.quotes |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << (i * 16);
+			m.commas |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, comma)))) << (i * 16);
+			m.newlines |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)))) << (i * 16);
+		}
+		return m;
 	}
 
-	static value_t _to_value(std::string&& s)
+	SIMD_TARGET_AVX2 inline s_csv_masks scan_csv_avx2(const char* p)
 	{
-		return value_t{ std::move(s) };
-	}
+		const __m256i quote = _mm256_set1_epi8('"');
+		const __m256i comma = _mm256_set1_epi8(',');
+		const __m256i newline = _mm256_set1_epi8('\n');
 
-	static value_t _to_value(std::string_view sv)
-	{
-		return value_t{ std::string(sv) };
-	}
+		const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
 
-	static value_t _to_value(const char* s)
-	{
-		return value_t{ std::string(s ? s : "") };
+		auto mask = [](__m256i a, __m256i b, __m256i c) SIMD_TARGET_AVX2 {
+			const uint64_t l = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, c)));
+			const uint64_t h = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, c)));
+			return l | (h << 32);
+			};
+
+		s_csv_masks m;
+		m.quotes = mask(lo, hi, quote);
+		m.commas = mask(lo, hi, comma);
+		m.newlines = mask(lo, hi, newline);
+		return m;
 	}
 
-	static value_t _to_value(char* s)
+	inline bool has_avx2()
 	{
-		return value_t{ std::string(s ? s : "") };
+#ifdef _MSC_VER
+		int info[4] = {};
+		__cpuid(info, 0);
+		if (info[0] < 7) { return false; }
+
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) { return false; }
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
 	}
 
-	template <std::size_t n>
-	static value_t _to_value(const char(&lit)[n]);
+	inline bool has_avx512()
+	{
+#ifdef _MSC_VER
+		int info[4] = {};
+		__cpuid(info, 0);
+		if (info[0] < 7) { return false; }
 
-	template <class t>
-	static value_t _to_value(const t&) = delete;
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		if (!osxsave || (_xgetbv(0) & 0xe6) != 0xe6) { return false; }
 
-	static std::vector<value_t> _to_column(const std::vector<value_t>& v)
-	{
-		return v;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 16)) != 0;
+#else
+		return __builtin_cpu_supports("avx512f");
+#endif
 	}
+#endif
 
-	static std::vector<value_t> _to_column(std::vector<value_t>&& v)
+	/*
+	*	picked once per process from the widest instruction set the cpu supports; assignable so bench_csv can pin each scanner
+	*/
+	inline csv_scanner_t& csv_scanner()
 	{
-		return std::move(v);
+		static csv_scanner_t scanner = []() -> csv_scanner_t {
+#ifdef SIMD_X86
+			if (has_avx2()) { return scan_csv_avx2; }
+			return scan_csv_sse2;
+#else
+			return scan_csv_scalar;
+#endif
+			}();
+		return scanner;
 	}
 
-	template<class t>
-	static std::vector<value_t> _to_column(const std::vector<t>& v);
-
-	template<class t>
-	static std::vector<value_t> _to_column(std::vector<t>&& v);
-
-	static std::vector<std::string> _parse_csv_line(const std::string& line)
+	/*
+	*	scans [p, end) in 64 byte blocks, the last partial block is zero padded; fn(block, masks, bytes) returns false to stop
+	*/
+	template<class fn_t>
+	void scan_csv_blocks(const char* p, const char* end, fn_t&& fn)
 	{
-		std::vector<std::string> fields;
+		const csv_scanner_t scan = csv_scanner();
 
-		std::string cur;
-		cur.reserve(line.size());
+		for (; p + 64 <= end; p += 64)
+		{
+			if (!fn(p, scan(p), size_t(64))) { return; }
+		}
 
-		bool in_quotes = false;
-		for (size_t i = 0; i < line.size(); ++i)
+		if (p < end)
 		{
-			char c = line[i];
-			if (in_quotes)
-			{
-				if (c == '"') {
-					if (i + 1 < line.size() && line[i + 1] == '"') { cur.push_back('"'); ++i; }
-					else { in_quotes = false; }
-				}
-				else cur.push_back(c);
-			}
-			else
+			alignas(64) char tail[64] = {};
+			const size_t n = static_cast<size_t>(end - p);
+			std::memcpy(tail, p, n);
+			fn(p, scan(tail), n);
+		}
+	}
+
+	/*
+	*	comparison kernels: bit i % 64 of out[i / 64] is set when p[i] op v holds. NaN satisfies only ne, like the scalar
+	*	operators
+	*/
+	template<class t>
+	inline void compare_scalar(const t* p, size_t n, e_compare op, double v, uint64_t* out)
+	{
+		auto run = [&](auto cmp) {
+			for (size_t i = 0; i < n; i += 64)
 			{
-				if (c == ',') { fields.emplace_back(std::move(cur)); cur.clear(); }
-				else if (c == '"') { in_quotes = true; }
-				else { cur.push_back(c); }
+				const size_t k = std::min<size_t>(64, n - i);
+				uint64_t bits = 0;
+				for (size_t j = 0; j < k; ++j) { bits |= static_cast<uint64_t>(cmp(static_cast<double>(p[i + j]), v)) << j; }
+				out[i / 64] = bits;
 			}
+			};
+
+		switch (op)
+		{
+		case e_compare::eq: run(std::equal_to<double>()); break;
+		case e_compare::ne: run(std::not_equal_to<double>()); break;
+		case e_compare::lt: run(std::less<double>()); break;
+		case e_compare::le: run(std::less_equal<double>()); break;
+		case e_compare::gt: run(std::greater<double>()); break;
+		case e_compare::ge: run(std::greater_equal<double>()); break;
 		}
+	}
 
-		fields.emplace_back(std::move(cur));
+	using compare_kernel_t = void(*)(const double*, size_t, e_compare, double, uint64_t*);
 
-		return fields;
+#ifdef SIMD_X86
+	template<e_compare op>
+	inline __m128d compare_sse2(__m128d a, __m128d b)
+	{
+		if constexpr (op == e_compare::eq) { return _mm_cmpeq_pd(a, b); }
+		else if constexpr (op == e_compare::ne) { return _mm_cmpneq_pd(a, b); }
+		else if constexpr (op == e_compare::lt) { return _mm_cmplt_pd(a, b); }
+		else if constexpr (op == e_compare::le) { return _mm_cmple_pd(a, b); }
+		else if constexpr (op == e_compare::gt) { return _mm_cmpgt_pd(a, b); }
+		else { return _mm_cmpge_pd(a, b); }
 	}
 
-	bool _append_column(const std::string& name, std::vector<value_t> values)
+	template<e_compare op>
+	inline void compare_f64_sse2(const double* p, size_t n, double v, uint64_t* out)
 	{
-		if (name.empty())
+		const __m128d b = _mm_set1_pd(v);
+
+		size_t i = 0;
+		for (; i + 64 <= n; i += 64)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return false;
+			uint64_t bits = 0;
+			for (unsigned j = 0; j < 64; j += 2) { bits |= static_cast<uint64_t>(_mm_movemask_pd(compare_sse2<op>(_mm_loadu_pd(p + i + j), b))) << j; }
+			out[i / 64] = bits;
 		}
 
-		if (values.empty())
+		if (i < n) { compare_scalar(p + i, n - i, op, v, out + i / 64); }
+	}
+
+	/*
+	*	_CMP_NEQ_UQ is unordered so NaN != v holds, the other predicates are ordered
+	*/
+	template<e_compare op>
+	SIMD_TARGET_AVX2 inline void compare_f64_avx2(const double* p, size_t n, double v, uint64_t* out)
+	{
+		constexpr int predicate = op == e_compare::eq ? _CMP_EQ_OQ : op == e_compare::ne ? _CMP_NEQ_UQ : op == e_compare::lt ? _CMP_LT_OQ :
+			op == e_compare::le ? _CMP_LE_OQ : op == e_compare::gt ? _CMP_GT_OQ : _CMP_GE_OQ;
+		const __m256d b = _mm256_set1_pd(v);
+
+		size_t i = 0;
+		for (; i + 64 <= n; i += 64)
 		{
-			c_logger::get().log("[c_dataframe]: No values\n", LOG_CLR_RED);
-			return false;
+			uint64_t bits = 0;
+			for (unsigned j = 0; j < 64; j += 4) { bits |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + i + j), b, predicate))) << j; }
+			out[i / 64] = bits;
 		}
 
-		if (this->m_rows == 0) { this->m_rows = values.size(); }
-		else if (values.size() != this->m_rows)
+		if (i < n) { compare_scalar(p + i, n - i, op, v, out + i / 64); }
+	}
+
+	inline void compare_sse2(const double* p, size_t n, e_compare op, double v, uint64_t* out)
+	{
+		switch (op)
 		{
-			c_logger::get().log("[c_dataframe]: Row length mismatch: " + name + "\n", LOG_CLR_RED);
-			return false;
+		case e_compare::eq: compare_f64_sse2<e_compare::eq>(p, n, v, out); break;
+		case e_compare::ne: compare_f64_sse2<e_compare::ne>(p, n, v, out); break;
+		case e_compare::lt: compare_f64_sse2<e_compare::lt>(p, n, v, out); break;
+		case e_compare::le: compare_f64_sse2<e_compare::le>(p, n, v, out); break;
+		case e_compare::gt: compare_f64_sse2<e_compare::gt>(p, n, v, out); break;
+		case e_compare::ge: compare_f64_sse2<e_compare::ge>(p, n, v, out); break;
 		}
+	}
 
-		auto [it, inserted] = this->m_data.emplace(name, std::move(values));
-		if (!inserted)
+	inline void compare_avx2(const double* p, size_t n, e_compare op, double v, uint64_t* out)
+	{
+		switch (op)
 		{
-			c_logger::get().log("[c_dataframe]: Duplicate column name: " + name + "\n", LOG_CLR_RED);
-			return false;
+		case e_compare::eq: compare_f64_avx2<e_compare::eq>(p, n, v, out); break;
+		case e_compare::ne: compare_f64_avx2<e_compare::ne>(p, n, v, out); break;
+		case e_compare::lt: compare_f64_avx2<e_compare::lt>(p, n, v, out); break;
+		case e_compare::le: compare_f64_avx2<e_compare::le>(p, n, v, out); break;
+		case e_compare::gt: compare_f64_avx2<e_compare::gt>(p, n, v, out); break;
+		case e_compare::ge: compare_f64_avx2<e_compare::ge>(p, n, v, out); break;
 		}
-
-		return true;
 	}
+#endif
 
-public:
-
-	c_dataframe() = default;
-
-	explicit c_dataframe(const std::string& csv_path, bool header = true)
+	/*
+	*	picked once per process like csv_scanner
+	*/
+	inline compare_kernel_t compare_f64()
 	{
-		this->from_csv(csv_path, header);
+		static const compare_kernel_t kernel = []() -> compare_kernel_t {
+#ifdef SIMD_X86
+			if (has_avx2()) { return compare_avx2; }
+			return compare_sse2;
+#else
+			return compare_scalar<double>;
+#endif
+			}();
+		return kernel;
 	}
 
-	~c_dataframe() {}
+	/*
+	*	reduction kernels over double spans. NaN lanes are masked out: sum adds 0, prod multiplies by 1 and min/max keep the
+	*	accumulator (minpd/maxpd return their second operand when either is NaN). var merges the count, mean and squared
+	*	deviations of the non-NaN values into a running accumulator, two passes over each L1-sized block
+	*/
+	struct s_reduce_kernels
+	{
+		double(*sum)(const double*, size_t);
+		double(*prod)(const double*, size_t);
+		double(*min)(const double*, size_t, double);
+		double(*max)(const double*, size_t, double);
+		void(*var)(const double*, size_t, size_t&, double&, double&);
+	};
+
+	inline double sum_f64_scalar(const double* p, size_t n)
+	{
+		double sum = 0.0;
+		for (size_t i = 0; i < n; ++i) { if (!std::isnan(p[i])) { sum += p[i]; } }
+		return sum;
+	}
 
-	bool add_column(const std::string& name, const std::vector<value_t>& values)
+	inline double prod_f64_scalar(const double* p, size_t n)
 	{
-		return this->_append_column(name, values);
+		double prod = 1.0;
+		for (size_t i = 0; i < n; ++i) { if (!std::isnan(p[i])) { prod *= p[i]; } }
+		return prod;
 	}
 
-	template<class t>
-	bool add_column(const std::string& name, const std::vector<t>& values);
+	inline double min_f64_scalar(const double* p, size_t n, double min)
+	{
+		for (size_t i = 0; i < n; ++i) { if (p[i] < min) { min = p[i]; } }
+		return min;
+	}
 
-	template<class t>
-	bool add_column(const std::string& name, std::vector<t>&& values);
+	inline double max_f64_scalar(const double* p, size_t n, double max)
+	{
+		for (size_t i = 0; i < n; ++i) { if (p[i] > max) { max = p[i]; } }
+		return max;
+	}
 
-	bool remove_column(const std::string& name)
+	/*
+	*	count, sum and squared deviations from the block mean of the non-NaN values of one block
+	*/
+	inline void block_var_scalar(const double* p, size_t n, size_t& count, double& sum, double& m2)
 	{
-		if (name.empty())
+		for (size_t i = 0; i < n; ++i) { if (!std::isnan(p[i])) { ++count; sum += p[i]; } }
+		if (!count) { return; }
+
+		const double mean = sum / static_cast<double>(count);
+		for (size_t i = 0; i < n; ++i)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return false;
+			const double d = p[i] - mean;
+			if (!std::isnan(d)) { m2 += d * d; }
 		}
-
-		const size_t erased = this->m_data.erase(name);
-		if (erased && this->m_data.empty()) { this->m_rows = 0; }
-
-		return erased != 0;
 	}
 
-	bool remove_column(const std::vector<std::string>& names)
+	/*
+	*	blocks are combined with Chan's pairwise update
+	*/
+	template<void(*block_var)(const double*, size_t, size_t&, double&, double&)>
+	inline void var_f64(const double* p, size_t n, size_t& count, double& mean, double& m2)
 	{
-		if (names.empty())
+		constexpr size_t block = 1024;
+
+		for (size_t b = 0; b < n; b += block)
 		{
-			c_logger::get().log("[c_dataframe]: No column names\n", LOG_CLR_RED);
-			return false;
+			size_t c = 0;
+			double sum = 0.0;
+			double q = 0.0;
+			block_var(p + b, std::min(block, n - b), c, sum, q);
+			if (!c) { continue; }
+
+			const double na = static_cast<double>(count);
+			const double nb = static_cast<double>(c);
+			const double delta = sum / nb - mean;
+			mean += delta * nb / (na + nb);
+			m2 += q + delta * delta * na * nb / (na + nb);
+			count += c;
 		}
+	}
 
-		for (const auto& k : names)
+#ifdef SIMD_X86
+	inline double sum_f64_sse2(const double* p, size_t n)
+	{
+		__m128d a0 = _mm_setzero_pd();
+		__m128d a1 = _mm_setzero_pd();
+
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
 		{
-			this->m_data.erase(k);
+			const __m128d x0 = _mm_loadu_pd(p + i);
+			const __m128d x1 = _mm_loadu_pd(p + i + 2);
+			a0 = _mm_add_pd(a0, _mm_and_pd(x0, _mm_cmpord_pd(x0, x0)));
+			a1 = _mm_add_pd(a1, _mm_and_pd(x1, _mm_cmpord_pd(x1, x1)));
 		}
 
-		if (this->m_data.empty()) { this->m_rows = 0; }
-
-		return true;
+		alignas(16) double lanes[2];
+		_mm_store_pd(lanes, _mm_add_pd(a0, a1));
+		return lanes[0] + lanes[1] + sum_f64_scalar(p + i, n - i);
 	}
 
-	bool rename_column(const std::string& old_name, const std::string& new_name)
+	inline double prod_f64_sse2(const double* p, size_t n)
 	{
-		if (old_name.empty() || new_name.empty())
+		const __m128d one = _mm_set1_pd(1.0);
+		__m128d a0 = one;
+		__m128d a1 = one;
+
+		auto masked = [&](__m128d x) {
+			const __m128d m = _mm_cmpord_pd(x, x);
+			return _mm_or_pd(_mm_and_pd(m, x), _mm_andnot_pd(m, one));
+			};
+
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return false;
+			a0 = _mm_mul_pd(a0, masked(_mm_loadu_pd(p + i)));
+			a1 = _mm_mul_pd(a1, masked(_mm_loadu_pd(p + i + 2)));
 		}
 
-		auto it = m_data.find(old_name);
-		if (it == m_data.end())
-		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return false;
-		}
-
-		if (m_data.find(new_name) != m_data.end())
-		{
-			c_logger::get().log("[c_dataframe]: Duplicate column name: " + new_name + "\n", LOG_CLR_RED);
-			return false;
-		}
-
-		m_data.emplace(new_name, std::move(it->second));
-		m_data.erase(it);
-
-		return true;
+		alignas(16) double lanes[2];
+		_mm_store_pd(lanes, _mm_mul_pd(a0, a1));
+		return lanes[0] * lanes[1] * prod_f64_scalar(p + i, n - i);
 	}
 
-	bool dropf()
+	inline double min_f64_sse2(const double* p, size_t n, double min)
 	{
-		if (!this->m_rows) { return false; }
+		__m128d a = _mm_set1_pd(min);
 
-		for (auto& [name, col] : this->m_data) { col.erase(col.begin()); }
-		this->m_rows--;
+		size_t i = 0;
+		for (; i + 2 <= n; i += 2) { a = _mm_min_pd(_mm_loadu_pd(p + i), a); }
 
-		return true;
+		alignas(16) double lanes[2];
+		_mm_store_pd(lanes, a);
+		return min_f64_scalar(p + i, n - i, std::min(lanes[0], lanes[1]));
 	}
 
-	bool dropb()
+	inline double max_f64_sse2(const double* p, size_t n, double max)
 	{
-		if (!this->m_rows) { return false; }
+		__m128d a = _mm_set1_pd(max);
 
-		for (auto& [name, col] : this->m_data) { col.pop_back(); }
-		this->m_rows--;
+		size_t i = 0;
+		for (; i + 2 <= n; i += 2) { a = _mm_max_pd(_mm_loadu_pd(p + i), a); }
 
-		return true;
+		alignas(16) double lanes[2];
+		_mm_store_pd(lanes, a);
+		return max_f64_scalar(p + i, n - i, std::max(lanes[0], lanes[1]));
 	}
 
-	bool drop(size_t index)
+	inline void block_var_sse2(const double* p, size_t n, size_t& count, double& sum, double& m2)
 	{
-		if (!this->m_rows || index >= this->m_rows) { return false; }
+		const __m128d one = _mm_set1_pd(1.0);
+		__m128d c = _mm_setzero_pd();
+		__m128d s = _mm_setzero_pd();
 
-		for (auto& [name, col] : this->m_data) { col.erase(col.begin() + index); }
-		this->m_rows--;
+		size_t i = 0;
+		for (; i + 2 <= n; i += 2)
+		{
+			const __m128d x = _mm_loadu_pd(p + i);
+			const __m128d m = _mm_cmpord_pd(x, x);
+			c = _mm_add_pd(c, _mm_and_pd(m, one));
+			s = _mm_add_pd(s, _mm_and_pd(m, x));
+		}
 
-		return true;
+		alignas(16) double lanes[2];
+		_mm_store_pd(lanes, c);
+		count += static_cast<size_t>(lanes[0] + lanes[1]);
+		_mm_store_pd(lanes, s);
+		sum += lanes[0] + lanes[1];
+		if (i < n && !std::isnan(p[i])) { ++count; sum += p[i]; }
+		if (!count) { return; }
+
+		const __m128d mean = _mm_set1_pd(sum / static_cast<double>(count));
+		__m128d q = _mm_setzero_pd();
+		for (i = 0; i + 2 <= n; i += 2)
+		{
+			const __m128d x = _mm_loadu_pd(p + i);
+			const __m128d d = _mm_and_pd(_mm_sub_pd(x, mean), _mm_cmpord_pd(x, x));
+			q = _mm_add_pd(q, _mm_mul_pd(d, d));
+		}
+
+		_mm_store_pd(lanes, q);
+		m2 += lanes[0] + lanes[1];
+		if (i < n && !std::isnan(p[i])) { const double d = p[i] - sum / static_cast<double>(count); m2 += d * d; }
 	}
 
-	bool dropna()
+	/*
+	*	NaN lanes replaced by 0 for sums and by 1 for products
+	*/
+	SIMD_TARGET_AVX2 inline __m256d nan_to_zero_avx2(__m256d x)
 	{
-		if (!this->m_rows) { return false; }
+		return _mm256_and_pd(x, _mm256_cmp_pd(x, x, _CMP_ORD_Q));
+	}
 
-		auto is_str_nan = [](const std::string& s) -> bool {
-			if (s.size() != 3) { return false; }
-			auto tl = [](unsigned char c) { return static_cast<char>(std::tolower(c)); };
-			return tl(s[0]) == 'n' && tl(s[1]) == 'a' && tl(s[2]) == 'n';
-			};
+	SIMD_TARGET_AVX2 inline __m256d nan_to_one_avx2(__m256d x, __m256d one)
+	{
+		return _mm256_blendv_pd(one, x, _mm256_cmp_pd(x, x, _CMP_ORD_Q));
+	}
 
-		std::vector<size_t> rows_to_drop;
-		rows_to_drop.reserve(this->m_rows);
+	SIMD_TARGET_AVX2 inline double sum_f64_avx2(const double* p, size_t n)
+	{
+		__m256d a0 = _mm256_setzero_pd();
+		__m256d a1 = _mm256_setzero_pd();
+		__m256d a2 = _mm256_setzero_pd();
+		__m256d a3 = _mm256_setzero_pd();
 
-		for (size_t i = 0; i < this->m_rows; ++i)
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
 		{
-			bool has_nan = false;
-			for (auto& [name, col] : m_data)
-			{
-				if (std::holds_alternative<double>(col[i]))
-				{
-					double v = std::get<double>(col[i]);
-					if (std::isnan(v))
-					{
-						has_nan = true;
-						break;
-					}
-				}
-				else
-				{
-					const std::string& v = std::get<std::string>(col[i]);
-					if (is_str_nan(v)) { has_nan = true; break; }
-				}
-			}
-			if (has_nan) { rows_to_drop.push_back(i); }
+			a0 = _mm256_add_pd(a0, nan_to_zero_avx2(_mm256_loadu_pd(p + i)));
+			a1 = _mm256_add_pd(a1, nan_to_zero_avx2(_mm256_loadu_pd(p + i + 4)));
+			a2 = _mm256_add_pd(a2, nan_to_zero_avx2(_mm256_loadu_pd(p + i + 8)));
+			a3 = _mm256_add_pd(a3, nan_to_zero_avx2(_mm256_loadu_pd(p + i + 12)));
 		}
 
-		if (rows_to_drop.empty()) { return false; }
+		alignas(32) double lanes[4];
+		_mm256_store_pd(lanes, _mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3)));
+		return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_f64_scalar(p + i, n - i);
+	}
+
+	SIMD_TARGET_AVX2 inline double prod_f64_avx2(const double* p, size_t n)
+	{
+		const __m256d one = _mm256_set1_pd(1.0);
 
-		std::sort(rows_to_drop.begin(), rows_to_drop.end());
-		rows_to_drop.erase(std::unique(rows_to_drop.begin(), rows_to_drop.end()), rows_to_drop.end());
+		__m256d a0 = one;
+		__m256d a1 = one;
+		__m256d a2 = one;
+		__m256d a3 = one;
 
-		for (auto it = rows_to_drop.rbegin(); it != rows_to_drop.rend(); ++it)
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
 		{
-			if (!this->drop(*it)) { return false; }
+			a0 = _mm256_mul_pd(a0, nan_to_one_avx2(_mm256_loadu_pd(p + i), one));
+			a1 = _mm256_mul_pd(a1, nan_to_one_avx2(_mm256_loadu_pd(p + i + 4), one));
+			a2 = _mm256_mul_pd(a2, nan_to_one_avx2(_mm256_loadu_pd(p + i + 8), one));
+			a3 = _mm256_mul_pd(a3, nan_to_one_avx2(_mm256_loadu_pd(p + i + 12), one));
 		}
 
-		return true;
+		alignas(32) double lanes[4];
+		_mm256_store_pd(lanes, _mm256_mul_pd(_mm256_mul_pd(a0, a1), _mm256_mul_pd(a2, a3)));
+		return lanes[0] * lanes[1] * lanes[2] * lanes[3] * prod_f64_scalar(p + i, n - i);
 	}
 
-	bool dropinf()
+	SIMD_TARGET_AVX2 inline double min_f64_avx2(const double* p, size_t n, double min)
 	{
-		if (!this->m_rows) { return false; }
+		__m256d a0 = _mm256_set1_pd(min);
+		__m256d a1 = a0;
 
-		auto is_str_inf = [](const std::string& s) -> bool {
-			if (s.size() < 3 || s.size() > 4) { return false; }
-			auto tl = [](unsigned char c) { return static_cast<char>(std::tolower(c)); };
-			size_t start = 0;
-			if (s[0] == '+' || s[0] == '-') { start = 1; }
-			if (s.size() - start != 3) { return false; }
-			return tl(s[start]) == 'i' && tl(s[start + 1]) == 'n' && tl(s[start + 2]) == 'f';
-			};
-
-		std::vector<size_t> rows_to_drop;
-		rows_to_drop.reserve(this->m_rows);
-
-		for (size_t i = 0; i < this->m_rows; ++i)
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
 		{
-			bool has_inf = false;
-			for (auto& [name, col] : m_data)
-			{
-				if (std::holds_alternative<double>(col[i]))
-				{
-					double v = std::get<double>(col[i]);
-					if (std::isinf(v))
-					{
-						has_inf = true;
-						break;
-					}
-				}
-				else
-				{
-					const std::string& v = std::get<std::string>(col[i]);
-					if (is_str_inf(v)) { has_inf = true; break; }
-				}
-			}
-			if (has_inf) { rows_to_drop.push_back(i); }
+			a0 = _mm256_min_pd(_mm256_loadu_pd(p + i), a0);
+			a1 = _mm256_min_pd(_mm256_loadu_pd(p + i + 4), a1);
 		}
 
-		if (rows_to_drop.empty()) { return false; }
+		alignas(32) double lanes[4];
+		_mm256_store_pd(lanes, _mm256_min_pd(a0, a1));
+		return min_f64_scalar(p + i, n - i, std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3])));
+	}
 
-		std::sort(rows_to_drop.begin(), rows_to_drop.end());
-		rows_to_drop.erase(std::unique(rows_to_drop.begin(), rows_to_drop.end()), rows_to_drop.end());
+	SIMD_TARGET_AVX2 inline double max_f64_avx2(const double* p, size_t n, double max)
+	{
+		__m256d a0 = _mm256_set1_pd(max);
+		__m256d a1 = a0;
 
-		for (auto it = rows_to_drop.rbegin(); it != rows_to_drop.rend(); ++it)
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
 		{
-			if (!this->drop(*it)) { return false; }
+			a0 = _mm256_max_pd(_mm256_loadu_pd(p + i), a0);
+			a1 = _mm256_max_pd(_mm256_loadu_pd(p + i + 4), a1);
 		}
 
-		return true;
+		alignas(32) double lanes[4];
+		_mm256_store_pd(lanes, _mm256_max_pd(a0, a1));
+		return max_f64_scalar(p + i, n - i, std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3])));
 	}
 
-	bool dropemp()
+	SIMD_TARGET_AVX2 inline void block_var_avx2(const double* p, size_t n, size_t& count, double& sum, double& m2)
 	{
-		if (!this->m_rows) { return false; }
-
-		std::vector<size_t> rows_to_drop;
-		rows_to_drop.reserve(this->m_rows);
+		const __m256d one = _mm256_set1_pd(1.0);
+		__m256d c = _mm256_setzero_pd();
+		__m256d s = _mm256_setzero_pd();
 
-		for (size_t i = 0; i < this->m_rows; ++i)
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4)
 		{
-			bool has_empty = false;
-			for (auto& [name, col] : m_data)
-			{
-				if (std::holds_alternative<std::string>(col[i]))
-				{
-					const std::string& v = std::get<std::string>(col[i]);
-					if (_is_blank(v))
-					{
-						has_empty = true;
-						break;
-					}
-				}
-			}
-			if (has_empty) { rows_to_drop.push_back(i); }
+			const __m256d x = _mm256_loadu_pd(p + i);
+			const __m256d m = _mm256_cmp_pd(x, x, _CMP_ORD_Q);
+			c = _mm256_add_pd(c, _mm256_and_pd(m, one));
+			s = _mm256_add_pd(s, _mm256_and_pd(m, x));
 		}
 
-		if (rows_to_drop.empty()) { return false; }
-
-		std::sort(rows_to_drop.begin(), rows_to_drop.end());
-		rows_to_drop.erase(std::unique(rows_to_drop.begin(), rows_to_drop.end()), rows_to_drop.end());
-
-		for (auto it = rows_to_drop.rbegin(); it != rows_to_drop.rend(); ++it)
+		alignas(32) double lanes[4];
+		_mm256_store_pd(lanes, c);
+		count += static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+		_mm256_store_pd(lanes, s);
+		sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+		for (size_t j = i; j < n; ++j) { if (!std::isnan(p[j])) { ++count; sum += p[j]; } }
+		if (!count) { return; }
+
+		const double mean = sum / static_cast<double>(count);
+		const __m256d mv = _mm256_set1_pd(mean);
+		__m256d q = _mm256_setzero_pd();
+		for (i = 0; i + 4 <= n; i += 4)
 		{
-			if (!this->drop(*it)) { return false; }
+			const __m256d x = _mm256_loadu_pd(p + i);
+			const __m256d d = _mm256_and_pd(_mm256_sub_pd(x, mv), _mm256_cmp_pd(x, x, _CMP_ORD_Q));
+			q = _mm256_add_pd(q, _mm256_mul_pd(d, d));
 		}
 
-		return true;
+		_mm256_store_pd(lanes, q);
+		m2 += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+		for (; i < n; ++i)
+		{
+			const double d = p[i] - mean;
+			if (!std::isnan(d)) { m2 += d * d; }
+		}
 	}
 
-	std::vector<value_t>& at(const std::string& name)
+	/*
+	*	AVX-512 keeps the NaN test in a mask register and loads the tail with a masked load instead of a scalar loop. min/max
+	*	use the masked forms with every lane set; the unmasked ones trip a -Wuninitialized false positive in GCC 12 headers
+	*/
+	SIMD_TARGET_AVX512 inline __mmask8 tail_mask(size_t left)
 	{
-		auto it = this->m_data.find(name);
-		if (it != this->m_data.end()) { return it->second; }
+		return static_cast<__mmask8>((1u << left) - 1);
+	}
 
-		std::vector<value_t> v;
-		v.resize(this->m_rows, value_t{std::string{}});
+	SIMD_TARGET_AVX512 inline double sum_f64_avx512(const double* p, size_t n)
+	{
+		__m512d a0 = _mm512_setzero_pd();
+		__m512d a1 = _mm512_setzero_pd();
 
-		auto [ins, ok] = this->m_data.emplace(name, std::move(v));
-		return ins->second;
-	}
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			const __m512d x0 = _mm512_loadu_pd(p + i);
+			const __m512d x1 = _mm512_loadu_pd(p + i + 8);
+			a0 = _mm512_mask_add_pd(a0, _mm512_cmp_pd_mask(x0, x0, _CMP_ORD_Q), a0, x0);
+			a1 = _mm512_mask_add_pd(a1, _mm512_cmp_pd_mask(x1, x1, _CMP_ORD_Q), a1, x1);
+		}
 
-	template<typename t>
-	std::vector<t> at(const std::string& name);
+		for (; i < n; i += 8)
+		{
+			const __mmask8 t = n - i >= 8 ? static_cast<__mmask8>(0xff) : tail_mask(n - i);
+			const __m512d x = _mm512_maskz_loadu_pd(t, p + i);
+			a0 = _mm512_mask_add_pd(a0, _mm512_mask_cmp_pd_mask(t, x, x, _CMP_ORD_Q), a0, x);
+		}
 
-	template<typename t>
-	std::vector<std::vector<t>> at(const std::vector<std::string>& names);
+		alignas(64) double lanes[8];
+		_mm512_store_pd(lanes, _mm512_add_pd(a0, a1));
+		return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+	}
 
-	bool from_csv(const std::string& csv_path, bool header = true)
+	SIMD_TARGET_AVX512 inline double prod_f64_avx512(const double* p, size_t n)
 	{
-		if (csv_path.empty()) { return false; }
+		__m512d a0 = _mm512_set1_pd(1.0);
+		__m512d a1 = a0;
 
-		if (this->m_data.size() || this->m_rows)
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
 		{
-			c_logger::get().log("[c_dataframe]: Already initialized\n", LOG_CLR_RED);
-			return false;
+			const __m512d x0 = _mm512_loadu_pd(p + i);
+			const __m512d x1 = _mm512_loadu_pd(p + i + 8);
+			a0 = _mm512_mask_mul_pd(a0, _mm512_cmp_pd_mask(x0, x0, _CMP_ORD_Q), a0, x0);
+			a1 = _mm512_mask_mul_pd(a1, _mm512_cmp_pd_mask(x1, x1, _CMP_ORD_Q), a1, x1);
 		}
 
-		std::ifstream file(csv_path);
-		if (!file.is_open()) { return false; }
+		for (; i < n; i += 8)
+		{
+			const __mmask8 t = n - i >= 8 ? static_cast<__mmask8>(0xff) : tail_mask(n - i);
+			const __m512d x = _mm512_maskz_loadu_pd(t, p + i);
+			a0 = _mm512_mask_mul_pd(a0, _mm512_mask_cmp_pd_mask(t, x, x, _CMP_ORD_Q), a0, x);
+		}
+
+		alignas(64) double lanes[8];
+		_mm512_store_pd(lanes, _mm512_mul_pd(a0, a1));
+		return ((lanes[0] * lanes[1]) * (lanes[2] * lanes[3])) * ((lanes[4] * lanes[5]) * (lanes[6] * lanes[7]));
+	}
 
-		std::vector<std::vector<std::string>> values;
+	SIMD_TARGET_AVX512 inline double min_f64_avx512(const double* p, size_t n, double min)
+	{
+		const __mmask8 all = 0xff;
+		__m512d a0 = _mm512_set1_pd(min);
+		__m512d a1 = a0;
 
-		std::string line;
-		while (std::getline(file, line))
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
 		{
-			std::vector<std::string> fields = _parse_csv_line(line);
-			values.resize(fields.size());
-			for (int i = 0; i < fields.size(); ++i) { values[i].push_back(fields[i]); }
+			a0 = _mm512_mask_min_pd(a0, all, _mm512_loadu_pd(p + i), a0);
+			a1 = _mm512_mask_min_pd(a1, all, _mm512_loadu_pd(p + i + 8), a1);
 		}
 
-		if (header)
+		for (; i < n; i += 8)
 		{
-			this->m_rows = values.back().size() - 1;
+			const __mmask8 t = n - i >= 8 ? static_cast<__mmask8>(0xff) : tail_mask(n - i);
+			a0 = _mm512_mask_min_pd(a0, t, _mm512_maskz_loadu_pd(t, p + i), a0);
+		}
 
-			for (size_t i = 0; i < values.size(); ++i)
-			{
-				const std::string name = values[i][0];
+		alignas(64) double lanes[8];
+		_mm512_store_pd(lanes, _mm512_mask_min_pd(a0, all, a0, a1));
+		return *std::min_element(lanes, lanes + 8);
+	}
 
-				for (size_t j = 1; j < values[i].size(); ++j)
-				{
-					this->m_data[name].push_back(_to_value(values[i][j]));
-				}
-			}
-		}
-		else
-		{
-			this->m_rows = values.back().size();
+	SIMD_TARGET_AVX512 inline double max_f64_avx512(const double* p, size_t n, double max)
+	{
+		const __mmask8 all = 0xff;
+		__m512d a0 = _mm512_set1_pd(max);
+		__m512d a1 = a0;
 
-			for (size_t i = 0; i < values.size(); ++i)
-			{
-				const std::string name = "col_" + std::to_string(i);
+		size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			a0 = _mm512_mask_max_pd(a0, all, _mm512_loadu_pd(p + i), a0);
+			a1 = _mm512_mask_max_pd(a1, all, _mm512_loadu_pd(p + i + 8), a1);
+		}
 
-				for (size_t j = 0; j < values[i].size(); ++j)
-				{
-					this->m_data[name].push_back(_to_value(values[i][j]));
-				}
-			}
+		for (; i < n; i += 8)
+		{
+			const __mmask8 t = n - i >= 8 ? static_cast<__mmask8>(0xff) : tail_mask(n - i);
+			a0 = _mm512_mask_max_pd(a0, t, _mm512_maskz_loadu_pd(t, p + i), a0);
 		}
 
-		return true;
+		alignas(64) double lanes[8];
+		_mm512_store_pd(lanes, _mm512_mask_max_pd(a0, all, a0, a1));
+		return *std::max_element(lanes, lanes + 8);
 	}
 
-	bool to_csv(const std::string& csv_path, bool header = true) const
+	SIMD_TARGET_AVX512 inline void block_var_avx512(const double* p, size_t n, size_t& count, double& sum, double& m2)
 	{
-		if (csv_path.empty() || this->m_data.empty() || !this->m_rows) { return false; }
-
-		std::ofstream file(csv_path, std::ios::out);
-		if (!file.is_open()) { return false; }
+		alignas(64) double lanes[8];
 
-		if (header)
+		__m512d s = _mm512_setzero_pd();
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
 		{
-			int i = 0;
-			for (const auto& [key, value] : this->m_data)
-			{
-				file << key;
-				if (i + 1 < this->m_data.size()) { file << ','; }
-				i++;
-			}
+			const __m512d x = _mm512_loadu_pd(p + i);
+			const __mmask8 m = _mm512_cmp_pd_mask(x, x, _CMP_ORD_Q);
+			count += popcount(m);
+			s = _mm512_mask_add_pd(s, m, s, x);
 		}
-
-		for (size_t i = 0; i < this->m_rows; ++i)
+		if (i < n)
 		{
-			if (header) { file << "\n"; }
+			const __mmask8 t = tail_mask(n - i);
+			const __m512d x = _mm512_maskz_loadu_pd(t, p + i);
+			const __mmask8 m = _mm512_mask_cmp_pd_mask(t, x, x, _CMP_ORD_Q);
+			count += popcount(m);
+			s = _mm512_mask_add_pd(s, m, s, x);
+		}
 
-			int j = 0;
-			for (const auto& [key, value] : this->m_data)
-			{
-				const value_t& v = value[i];
-				file << _value_to_string(v);
-				if (j + 1 < this->m_data.size()) { file << ','; }
-				j++;
-			}
+		_mm512_store_pd(lanes, s);
+		sum += ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+		if (!count) { return; }
 
-			if (!header) { file << "\n"; }
+		const __m512d mean = _mm512_set1_pd(sum / static_cast<double>(count));
+		__m512d q = _mm512_setzero_pd();
+		for (i = 0; i + 8 <= n; i += 8)
+		{
+			const __m512d x = _mm512_loadu_pd(p + i);
+			const __m512d d = _mm512_sub_pd(x, mean);
+			q = _mm512_mask_add_pd(q, _mm512_cmp_pd_mask(x, x, _CMP_ORD_Q), q, _mm512_mul_pd(d, d));
+		}
+		if (i < n)
+		{
+			const __mmask8 t = tail_mask(n - i);
+			const __m512d x = _mm512_maskz_loadu_pd(t, p + i);
+			const __m512d d = _mm512_sub_pd(x, mean);
+			q = _mm512_mask_add_pd(q, _mm512_mask_cmp_pd_mask(t, x, x, _CMP_ORD_Q), q, _mm512_mul_pd(d, d));
 		}
 
-		return true;
+		_mm512_store_pd(lanes, q);
+		m2 += ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
 	}
+#endif
 
-	std::pair<size_t, size_t> shape() const
+	/*
+	*	picked once per process like csv_scanner
+	*/
+	inline const s_reduce_kernels& reduce_f64()
 	{
-		return { this->m_rows, this->m_data.size() };
+		static const s_reduce_kernels kernels = []() -> s_reduce_kernels {
+#ifdef SIMD_X86
+			if (has_avx512()) { return { sum_f64_avx512, prod_f64_avx512, min_f64_avx512, max_f64_avx512, var_f64<block_var_avx512> }; }
+			if (has_avx2()) { return { sum_f64_avx2, prod_f64_avx2, min_f64_avx2, max_f64_avx2, var_f64<block_var_avx2> }; }
+			return { sum_f64_sse2, prod_f64_sse2, min_f64_sse2, max_f64_sse2, var_f64<block_var_sse2> };
+#else
+			return { sum_f64_scalar, prod_f64_scalar, min_f64_scalar, max_f64_scalar, var_f64<block_var_scalar> };
+#endif
+			}();
+		return kernels;
 	}
 
-	double sum(const std::string& name, size_t from = 0, size_t length = 0) const
+	/*
+	*	gram kernels: g[(i + a) * n + j + b] += sum over r of x[(i + a) * rows + r] * x[(j + b) * rows + r] for the 4 x 4
+	*	tile at (i, j), x holding the columns of a block one after another. rows is a multiple of 4
+	*/
+	using gram_kernel_t = void(*)(const double*, size_t, size_t, size_t, double*, size_t);
+
+	inline void gram_4x4_scalar(const double* x, size_t rows, size_t i, size_t j, double* g, size_t n)
 	{
-		if (name.empty())
+		double acc[4][4] = {};
+		for (size_t r = 0; r < rows; ++r)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return std::numeric_limits<double>::quiet_NaN();
+			for (unsigned a = 0; a < 4; ++a)
+			{
+				const double xa = x[(i + a) * rows + r];
+				for (unsigned b = 0; b < 4; ++b) { acc[a][b] += xa * x[(j + b) * rows + r]; }
+			}
 		}
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return std::numeric_limits<double>::quiet_NaN(); }
-
-		const auto& col = it->second;
+		for (unsigned a = 0; a < 4; ++a)
+		{
+			for (unsigned b = 0; b < 4; ++b) { g[(i + a) * n + j + b] += acc[a][b]; }
+		}
+	}
 
-		const size_t n = col.size();
-		if (n == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+#ifdef SIMD_X86
+	SIMD_TARGET_AVX2 inline double hsum_avx2(__m256d v)
+	{
+		alignas(32) double lanes[4];
+		_mm256_store_pd(lanes, v);
+		return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	}
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	/*
+	*	two rows of the tile at a time keep the 8 accumulators and the loaded values within the 16 ymm registers
+	*/
+	SIMD_TARGET_AVX2 inline void gram_4x4_avx2(const double* x, size_t rows, size_t i, size_t j, double* g, size_t n)
+	{
+		const double* b0 = x + j * rows;
+		const double* b1 = b0 + rows;
+		const double* b2 = b1 + rows;
+		const double* b3 = b2 + rows;
 
-		double sum = 0.0;
-		for (size_t i = from; i < from + length; ++i)
+		for (size_t h = 0; h < 4; h += 2)
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
+			const double* a0 = x + (i + h) * rows;
+			const double* a1 = a0 + rows;
 
-			if (std::holds_alternative<double>(col[i]))
-			{
-				d = std::get<double>(col[i]);
-			}
-			else
+			__m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd(), c02 = _mm256_setzero_pd(), c03 = _mm256_setzero_pd();
+			__m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd(), c12 = _mm256_setzero_pd(), c13 = _mm256_setzero_pd();
+			for (size_t r = 0; r < rows; r += 4)
 			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
+				const __m256d x0 = _mm256_loadu_pd(a0 + r);
+				const __m256d x1 = _mm256_loadu_pd(a1 + r);
+
+				__m256d y = _mm256_loadu_pd(b0 + r);
+				c00 = _mm256_add_pd(c00, _mm256_mul_pd(x0, y));
+				c10 = _mm256_add_pd(c10, _mm256_mul_pd(x1, y));
+				y = _mm256_loadu_pd(b1 + r);
+				c01 = _mm256_add_pd(c01, _mm256_mul_pd(x0, y));
+				c11 = _mm256_add_pd(c11, _mm256_mul_pd(x1, y));
+				y = _mm256_loadu_pd(b2 + r);
+				c02 = _mm256_add_pd(c02, _mm256_mul_pd(x0, y));
+				c12 = _mm256_add_pd(c12, _mm256_mul_pd(x1, y));
+				y = _mm256_loadu_pd(b3 + r);
+				c03 = _mm256_add_pd(c03, _mm256_mul_pd(x0, y));
+				c13 = _mm256_add_pd(c13, _mm256_mul_pd(x1, y));
 			}
 
-			if (!std::isnan(d))
-			{
-				sum += d;
-			}
+			double* g0 = g + (i + h) * n + j;
+			double* g1 = g0 + n;
+			g0[0] += hsum_avx2(c00); g0[1] += hsum_avx2(c01); g0[2] += hsum_avx2(c02); g0[3] += hsum_avx2(c03);
+			g1[0] += hsum_avx2(c10); g1[1] += hsum_avx2(c11); g1[2] += hsum_avx2(c12); g1[3] += hsum_avx2(c13);
 		}
-
-		return sum;
 	}
+#endif
 
-	double prod(const std::string& name, size_t from = 0, size_t length = 0) const
+	/*
+	*	picked once per process like csv_scanner
+	*/
+	inline gram_kernel_t gram_4x4()
 	{
-		if (name.empty())
-		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return std::numeric_limits<double>::quiet_NaN();
-		}
-
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return std::numeric_limits<double>::quiet_NaN(); }
-
-		const auto& col = it->second;
+		static const gram_kernel_t kernel = []() -> gram_kernel_t {
+#ifdef SIMD_X86
+			if (has_avx2()) { return gram_4x4_avx2; }
+#endif
+			return gram_4x4_scalar;
+			}();
+		return kernel;
+	}
 
-		const size_t n = col.size();
-		if (n == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	/*
+	*	scan kernels: out[i] is carry combined with p[0..i] (running sum / product); NaN values count as the identity and are
+	*	written through unchanged, the way the scalar loops skip them. returns the running value after p[n - 1]. out may
+	*	alias p
+	*/
+	using scan_kernel_t = double(*)(const double*, double*, size_t, double);
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	struct s_scan_kernels
+	{
+		scan_kernel_t sum;
+		scan_kernel_t prod;
+	};
 
-		double prod = 1.0;
-		for (size_t i = from; i < from + length; ++i)
+	inline double scan_sum_f64_scalar(const double* p, double* out, size_t n, double carry)
+	{
+		for (size_t i = 0; i < n; ++i)
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
-
-			if (std::holds_alternative<double>(col[i]))
-			{
-				d = std::get<double>(col[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
-			}
-
-			if (!std::isnan(d))
-			{
-				prod *= d;
-			}
+			const double x = p[i];
+			if (std::isnan(x)) { out[i] = x; continue; }
+			carry += x;
+			out[i] = carry;
 		}
-
-		return prod;
+		return carry;
 	}
 
-	double mean(const std::string& name, size_t from = 0, size_t length = 0) const
+	inline double scan_prod_f64_scalar(const double* p, double* out, size_t n, double carry)
 	{
-		if (name.empty())
+		for (size_t i = 0; i < n; ++i)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return std::numeric_limits<double>::quiet_NaN();
+			const double x = p[i];
+			if (std::isnan(x)) { out[i] = x; continue; }
+			carry *= x;
+			out[i] = carry;
 		}
+		return carry;
+	}
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return std::numeric_limits<double>::quiet_NaN(); }
-
-		const auto& col = it->second;
+#ifdef SIMD_X86
+	/*
+	*	inclusive scan within 4 lanes: add the vector shifted up by one lane, then by two, shifting in the identity id
+	*/
+	SIMD_TARGET_AVX2 inline __m256d scan_add_4_avx2(__m256d x, __m256d id)
+	{
+		x = _mm256_add_pd(x, _mm256_blend_pd(_mm256_permute4x64_pd(x, _MM_SHUFFLE(2, 1, 0, 0)), id, 0x1));
+		return _mm256_add_pd(x, _mm256_blend_pd(_mm256_permute4x64_pd(x, _MM_SHUFFLE(1, 0, 0, 0)), id, 0x3));
+	}
 
-		const size_t n = col.size();
-		if (n == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	SIMD_TARGET_AVX2 inline __m256d scan_mul_4_avx2(__m256d x, __m256d id)
+	{
+		x = _mm256_mul_pd(x, _mm256_blend_pd(_mm256_permute4x64_pd(x, _MM_SHUFFLE(2, 1, 0, 0)), id, 0x1));
+		return _mm256_mul_pd(x, _mm256_blend_pd(_mm256_permute4x64_pd(x, _MM_SHUFFLE(1, 0, 0, 0)), id, 0x3));
+	}
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	/*
+	*	8 values per step: both halves are scanned independently, so the loop-carried chain is one add and one lane
+	*	broadcast per 8 values instead of one add per value
+	*/
+	SIMD_TARGET_AVX2 inline double scan_sum_f64_avx2(const double* p, double* out, size_t n, double carry)
+	{
+		const __m256d id = _mm256_set1_pd(-0.0);
+		__m256d c = _mm256_set1_pd(carry);
 
-		double mean = 0.0;
-		for (size_t i = from; i < from + length; ++i)
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
-
-			if (std::holds_alternative<double>(col[i]))
-			{
-				d = std::get<double>(col[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
-			}
-
-			if (!std::isnan(d))
-			{
-				mean += d;
-			}
+			const __m256d x0 = _mm256_loadu_pd(p + i);
+			const __m256d x1 = _mm256_loadu_pd(p + i + 4);
+			const __m256d m0 = _mm256_cmp_pd(x0, x0, _CMP_UNORD_Q);
+			const __m256d m1 = _mm256_cmp_pd(x1, x1, _CMP_UNORD_Q);
+
+			__m256d s0 = scan_add_4_avx2(_mm256_blendv_pd(x0, id, m0), id);
+			__m256d s1 = scan_add_4_avx2(_mm256_blendv_pd(x1, id, m1), id);
+			s1 = _mm256_add_pd(s1, _mm256_permute4x64_pd(s0, _MM_SHUFFLE(3, 3, 3, 3)));
+			s0 = _mm256_add_pd(c, s0);
+			s1 = _mm256_add_pd(c, s1);
+			c = _mm256_permute4x64_pd(s1, _MM_SHUFFLE(3, 3, 3, 3));
+
+			_mm256_storeu_pd(out + i, _mm256_blendv_pd(s0, x0, m0));
+			_mm256_storeu_pd(out + i + 4, _mm256_blendv_pd(s1, x1, m1));
 		}
 
-		return mean / static_cast<double>(length);
+		alignas(32) double lanes[4];
+		_mm256_store_pd(lanes, c);
+		return scan_sum_f64_scalar(p + i, out + i, n - i, lanes[0]);
 	}
 
-	double var(const std::string& name, size_t from = 0, size_t length = 0) const
+	SIMD_TARGET_AVX2 inline double scan_prod_f64_avx2(const double* p, double* out, size_t n, double carry)
 	{
-		if (name.empty())
+		const __m256d id = _mm256_set1_pd(1.0);
+		__m256d c = _mm256_set1_pd(carry);
+
+		size_t i = 0;
+		for (; i + 8 <= n; i += 8)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return std::numeric_limits<double>::quiet_NaN();
+			const __m256d x0 = _mm256_loadu_pd(p + i);
+			const __m256d x1 = _mm256_loadu_pd(p + i + 4);
+			const __m256d m0 = _mm256_cmp_pd(x0, x0, _CMP_UNORD_Q);
+			const __m256d m1 = _mm256_cmp_pd(x1, x1, _CMP_UNORD_Q);
+
+			__m256d s0 = scan_mul_4_avx2(_mm256_blendv_pd(x0, id, m0), id);
+			__m256d s1 = scan_mul_4_avx2(_mm256_blendv_pd(x1, id, m1), id);
+			s1 = _mm256_mul_pd(s1, _mm256_permute4x64_pd(s0, _MM_SHUFFLE(3, 3, 3, 3)));
+			s0 = _mm256_mul_pd(c, s0);
+			s1 = _mm256_mul_pd(c, s1);
+			c = _mm256_permute4x64_pd(s1, _MM_SHUFFLE(3, 3, 3, 3));
+
+			_mm256_storeu_pd(out + i, _mm256_blendv_pd(s0, x0, m0));
+			_mm256_storeu_pd(out + i + 4, _mm256_blendv_pd(s1, x1, m1));
 		}
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return std::numeric_limits<double>::quiet_NaN(); }
+		alignas(32) double lanes[4];
+		_mm256_store_pd(lanes, c);
+		return scan_prod_f64_scalar(p + i, out + i, n - i, lanes[0]);
+	}
+#endif
 
-		const auto& col = it->second;
+	inline const s_scan_kernels& scan_f64()
+	{
+		static const s_scan_kernels kernels = []() -> s_scan_kernels {
+#ifdef SIMD_X86
+			if (has_avx2()) { return { scan_sum_f64_avx2, scan_prod_f64_avx2 }; }
+#endif
+			return { scan_sum_f64_scalar, scan_prod_f64_scalar };
+			}();
+		return kernels;
+	}
+}
 
-		const size_t n = col.size();
-		if (n == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+class c_logger
+{
+private:
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	c_logger() {}
 
-		if (length < 2) { return 0.0; }
+	~c_logger() {}
 
-		double mean = 0.0;
-		double m2 = 0.0;
-		size_t k = 0;
-		for (size_t i = from; i < from + length; ++i)
-		{
-			double d = std::numeric_limits<double>::quiet_NaN();
+	c_logger(const c_logger&) = delete;
 
-			if (std::holds_alternative<double>(col[i]))
-			{
-				d = std::get<double>(col[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
-			}
+	c_logger& operator=(const c_logger&) = delete;
 
-			if (!std::isnan(d))
-			{
-				++k;
-				const double delta = d - mean;
-				mean += delta / static_cast<double>(k);
-				m2 += delta * (d - mean);
-			}
-		}
+public:
 
-		return m2 / static_cast<double>(length - 1);
+	static c_logger& get() noexcept
+	{
+		static c_logger instance;
+		return instance;
 	}
 
-	double std(const std::string& name, size_t from = 0, size_t length = 0) const
+	bool log(const std::string& msg, unsigned short color) noexcept
 	{
-		double v = this->var(name, from, length);
-		return std::isnan(v) ? v : std::sqrt(v);
+		if (msg.empty()) { return false; }
+		SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
+		std::cout << msg;
+		SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), LOG_CLR_NORMAL);
+		return true;
 	}
 
-	double min(const std::string& name, size_t from = 0, size_t length = 0) const
+	bool log_formatted(const std::string& msg, unsigned short color, int width) noexcept
 	{
-		if (name.empty())
-		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return std::numeric_limits<double>::quiet_NaN();
-		}
+		if (msg.empty()) { return false; }
+		SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
+		std::cout << std::setw(width) << std::left << msg;
+		SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), LOG_CLR_NORMAL);
+		return true;
+	}
+};
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return std::numeric_limits<double>::quiet_NaN(); }
+class c_thread_pool
+{
+private:
 
-		const auto& col = it->second;
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_queue;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+	bool m_stop = false;
 
-		const size_t n = col.size();
-		if (n == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	static bool& _is_worker() noexcept
+	{
+		thread_local bool worker = false;
+		return worker;
+	}
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	c_thread_pool()
+	{
+		const size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+		for (size_t i = 1; i < threads; ++i) { this->m_workers.emplace_back([this]() { this->_work(); }); }
+	}
 
-		double min = std::numeric_limits<double>::max();
-		for (size_t i = from; i < from + length; ++i)
+	~c_thread_pool()
+	{
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
-
-			if (std::holds_alternative<double>(col[i]))
-			{
-				d = std::get<double>(col[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
-			}
-
-			if (!std::isnan(d))
-			{
-				if (d < min) { min = d; }
-			}
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			this->m_stop = true;
 		}
-
-		return min;
+		this->m_cv.notify_all();
+		for (auto& worker : this->m_workers) { worker.join(); }
 	}
 
-	double max(const std::string& name, size_t from = 0, size_t length = 0) const
+	c_thread_pool(const c_thread_pool&) = delete;
+
+	c_thread_pool& operator=(const c_thread_pool&) = delete;
+
+	void _work()
 	{
-		if (name.empty())
+		_is_worker() = true;
+
+		while (true)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return std::numeric_limits<double>::quiet_NaN();
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(this->m_mutex);
+				this->m_cv.wait(lock, [this]() { return this->m_stop || !this->m_queue.empty(); });
+				if (this->m_stop && this->m_queue.empty()) { return; }
+
+				job = std::move(this->m_queue.front());
+				this->m_queue.pop_front();
+			}
+			job();
 		}
+	}
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return std::numeric_limits<double>::quiet_NaN(); }
+public:
 
-		const auto& col = it->second;
+	static c_thread_pool& get() noexcept
+	{
+		static c_thread_pool instance;
+		return instance;
+	}
 
-		const size_t n = col.size();
-		if (n == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	size_t size() const noexcept
+	{
+		return this->m_workers.size() + 1;
+	}
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	/*
+	*	runs fn(i) for every i in [0, tasks) on the workers and the calling thread, returns once all tasks finished;
+	*	calls made from inside a task run inline
+	*/
+	template<class fn_t>
+	void parallel_for(size_t tasks, fn_t&& fn)
+	{
+		if (!tasks) { return; }
 
-		double max = std::numeric_limits<double>::min();
-		for (size_t i = from; i < from + length; ++i)
+		if (tasks == 1 || this->m_workers.empty() || _is_worker())
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
+			for (size_t i = 0; i < tasks; ++i) { fn(i); }
+			return;
+		}
 
-			if (std::holds_alternative<double>(col[i]))
+		std::atomic<size_t> next{ 0 };
+		std::mutex done_mutex;
+		std::condition_variable done_cv;
+		std::exception_ptr error;
+		size_t pending = std::min(tasks - 1, this->m_workers.size());
+
+		auto run = [&]() {
+			try
 			{
-				d = std::get<double>(col[i]);
+				for (size_t i = next.fetch_add(1); i < tasks; i = next.fetch_add(1)) { fn(i); }
 			}
-			else
+			catch (...)
 			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
+				std::lock_guard<std::mutex> lock(done_mutex);
+				if (!error) { error = std::current_exception(); }
+				next = tasks;
 			}
+			};
 
-			if (!std::isnan(d))
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			for (size_t i = 0, n = pending; i < n; ++i)
 			{
-				if (d > max) { max = d; }
+				this->m_queue.emplace_back([&]() {
+					run();
+					std::lock_guard<std::mutex> lock(done_mutex);
+					if (--pending == 0) { done_cv.notify_one(); }
+					});
 			}
 		}
+		this->m_cv.notify_all();
 
-		return max;
-	}
+		run();
 
-	double cov(const std::string& name1, const std::string& name2, size_t from = 0, size_t length = 0) const
-	{
-		if (name1.empty() || name2.empty())
-		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return std::numeric_limits<double>::quiet_NaN();
-		}
+		std::unique_lock<std::mutex> lock(done_mutex);
+		done_cv.wait(lock, [&]() { return pending == 0; });
 
-		auto it1 = this->m_data.find(name1);
-		if (it1 == this->m_data.end()) { return std::numeric_limits<double>::quiet_NaN(); }
+		if (error) { std::rethrow_exception(error); }
+	}
+};
+
+class c_mapped_file
+{
+private:
 
-		auto it2 = this->m_data.find(name2);
-		if (it2 == this->m_data.end()) { return std::numeric_limits<double>::quiet_NaN(); }
+	const char* m_data = nullptr;
+	size_t m_size = 0;
+	bool m_open = false;
 
-		const auto& col1 = it1->second;
-		const auto& col2 = it2->second;
+#ifdef _WIN32
+	HANDLE m_file = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+#else
+	int m_fd = -1;
+#endif
 
-		const size_t n = col1.size();
-		if (n == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	void _close() noexcept
+	{
+#ifdef _WIN32
+		if (this->m_data) { UnmapViewOfFile(this->m_data); }
+		if (this->m_mapping) { CloseHandle(this->m_mapping); }
+		if (this->m_file != INVALID_HANDLE_VALUE) { CloseHandle(this->m_file); }
+		this->m_mapping = nullptr;
+		this->m_file = INVALID_HANDLE_VALUE;
+#else
+		if (this->m_data) { munmap(const_cast<char*>(this->m_data), this->m_size); }
+		if (this->m_fd >= 0) { ::close(this->m_fd); }
+		this->m_fd = -1;
+#endif
+		this->m_data = nullptr;
+		this->m_size = 0;
+		this->m_open = false;
+	}
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+public:
 
-		double mean1 = this->mean(name1, from, length);
-		double mean2 = this->mean(name2, from, length);
-		double covariance = 0.0;
-		for (size_t i = from; i < from + length; ++i)
-		{
-			double d1 = std::numeric_limits<double>::quiet_NaN();
-			double d2 = std::numeric_limits<double>::quiet_NaN();
+	explicit c_mapped_file(const std::string& path)
+	{
+#ifdef _WIN32
+		this->m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (this->m_file == INVALID_HANDLE_VALUE) { return; }
 
-			if (std::holds_alternative<double>(col1[i]))
-			{
-				d1 = std::get<double>(col1[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col1[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d1 = *parsed;
-			}
+		LARGE_INTEGER size = {};
+		if (!GetFileSizeEx(this->m_file, &size)) { this->_close(); return; }
 
-			if (std::holds_alternative<double>(col2[i]))
-			{
-				d2 = std::get<double>(col2[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col2[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d2 = *parsed;
-			}
+		this->m_size = static_cast<size_t>(size.QuadPart);
+		if (this->m_size)
+		{
+			this->m_mapping = CreateFileMappingA(this->m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!this->m_mapping) { this->_close(); return; }
 
-			if (!std::isnan(d1) && !std::isnan(d2))
-			{
-				covariance += ((d1 - mean1) * (d2 - mean2));
-			}
+			this->m_data = static_cast<const char*>(MapViewOfFile(this->m_mapping, FILE_MAP_READ, 0, 0, 0));
+			if (!this->m_data) { this->_close(); return; }
 		}
+#else
+		this->m_fd = ::open(path.c_str(), O_RDONLY);
+		if (this->m_fd < 0) { return; }
 
-		return covariance / (static_cast<double>(length) - 1);
-	}
+		struct stat st = {};
+		if (fstat(this->m_fd, &st) != 0) { this->_close(); return; }
 
-	double corr(const std::string& name1, const std::string& name2, size_t from = 0, size_t length = 0) const
-	{
-		if (name1.empty() || name2.empty())
+		this->m_size = static_cast<size_t>(st.st_size);
+		if (this->m_size)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return std::numeric_limits<double>::quiet_NaN();
+			void* p = mmap(nullptr, this->m_size, PROT_READ, MAP_PRIVATE, this->m_fd, 0);
+			if (p == MAP_FAILED) { this->_close(); return; }
+
+			madvise(p, this->m_size, MADV_SEQUENTIAL);
+			this->m_data = static_cast<const char*>(p);
 		}
+#endif
+		this->m_open = true;
+	}
 
-		double covariance = this->cov(name1, name2, from, length);
-		if (std::isnan(covariance)) { return std::numeric_limits<double>::quiet_NaN(); }
+	~c_mapped_file()
+	{
+		this->_close();
+	}
 
-		double std1 = this->std(name1, from, length);
-		if (std::isnan(std1)) { return std::numeric_limits<double>::quiet_NaN(); }
+	c_mapped_file(const c_mapped_file&) = delete;
 
-		double std2 = this->std(name2, from, length);
-		if (std::isnan(std2)) { return std::numeric_limits<double>::quiet_NaN(); }
+	c_mapped_file& operator=(const c_mapped_file&) = delete;
 
-		return covariance / (std1 * std2);
+	bool is_open() const noexcept
+	{
+		return this->m_open;
 	}
 
-	double skew(const std::string& name, size_t from = 0, size_t length = 0) const
+	const char* data() const noexcept
 	{
-		if (name.empty())
-		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return std::numeric_limits<double>::quiet_NaN();
-		}
-
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return std::numeric_limits<double>::quiet_NaN(); }
+		return this->m_data;
+	}
 
-		const auto& col = it->second;
+	size_t size() const noexcept
+	{
+		return this->m_size;
+	}
+};
 
-		const size_t n = col.size();
-		if (n == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+/*
+*	minimal flatbuffers support for arrow metadata. reads are bounds-checked against the buffer; the builder appends objects
+*	forward, so every child is written after the table that references it and uoffsets stay positive
+*/
+namespace n_flatbuffers
+{
+	template<class t>
+	inline bool read(const uint8_t* data, size_t size, size_t pos, t& v)
+	{
+		if (pos > size || size - pos < sizeof(t)) { return false; }
+		std::memcpy(&v, data + pos, sizeof(t));
+		return true;
+	}
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+	struct s_table;
 
-		double mean = this->mean(name, from, length);
-		double std = this->std(name, from, length);
-		double skewness = 0.0;
-		for (size_t i = from; i < from + length; ++i)
+	struct s_vector
+	{
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		size_t pos = 0;
+		size_t count = 0;
+
+		/*
+		*	element i of a vector of inline structs, nullptr when out of bounds
+		*/
+		const uint8_t* element(size_t i, size_t bytes) const
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
-
-			if (std::holds_alternative<double>(col[i]))
-			{
-				d = std::get<double>(col[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
-			}
-
-			if (!std::isnan(d))
-			{
-				skewness += std::pow((d - mean) / std, 3.0);
-			}
+			if (i >= this->count || this->pos + (i + 1) * bytes > this->size) { return nullptr; }
+			return this->data + this->pos + i * bytes;
 		}
 
-		return skewness / static_cast<double>(length);
-	}
+		s_table table(size_t i) const;
+	};
 
-	double kurt(const std::string& name, size_t from = 0, size_t length = 0) const
+	struct s_table
 	{
-		if (name.empty())
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		size_t pos = 0;
+
+		explicit operator bool() const noexcept
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return std::numeric_limits<double>::quiet_NaN();
+			return this->data != nullptr;
 		}
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return std::numeric_limits<double>::quiet_NaN(); }
+		/*
+		*	absolute position of field id, 0 when it is absent
+		*/
+		size_t field(size_t id) const
+		{
+			if (!this->data) { return 0; }
 
-		const auto& col = it->second;
+			int32_t back = 0;
+			if (!read(this->data, this->size, this->pos, back)) { return 0; }
 
-		const size_t n = col.size();
-		if (n == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+			const int64_t vtable = static_cast<int64_t>(this->pos) - back;
+			uint16_t vtable_size = 0, table_size = 0, offset = 0;
+			if (vtable < 0 || !read(this->data, this->size, static_cast<size_t>(vtable), vtable_size)) { return 0; }
+			if (!read(this->data, this->size, static_cast<size_t>(vtable) + 2, table_size)) { return 0; }
+			if (4 + 2 * id + 2 > vtable_size || !read(this->data, this->size, static_cast<size_t>(vtable) + 4 + 2 * id, offset)) { return 0; }
+			if (!offset || offset >= table_size) { return 0; }
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return std::numeric_limits<double>::quiet_NaN(); }
+			return this->pos + offset;
+		}
 
-		double mean = this->mean(name, from, length);
-		double std = this->std(name, from, length);
-		double kurtosis = 0.0;
-		for (size_t i = from; i < from + length; ++i)
+		template<class t>
+		t scalar(size_t id, t fallback) const
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
+			t v = fallback;
+			const size_t p = this->field(id);
+			if (!p || !read(this->data, this->size, p, v)) { return fallback; }
+			return v;
+		}
 
-			if (std::holds_alternative<double>(col[i]))
-			{
-				d = std::get<double>(col[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
-			}
+		size_t target(size_t id) const
+		{
+			uint32_t offset = 0;
+			const size_t p = this->field(id);
+			if (!p || !read(this->data, this->size, p, offset) || offset > this->size - p) { return 0; }
+			return p + offset;
+		}
 
-			if (!std::isnan(d))
-			{
-				kurtosis += std::pow((d - mean) / std, 4.0);
-			}
+		s_table table(size_t id) const
+		{
+			const size_t p = this->target(id);
+			if (!p) { return {}; }
+			return { this->data, this->size, p };
 		}
 
-		return (kurtosis / static_cast<double>(length) - 3.0);
-	}
+		std::string_view string(size_t id) const
+		{
+			uint32_t length = 0;
+			const size_t p = this->target(id);
+			if (!p || !read(this->data, this->size, p, length) || length > this->size - p - 4) { return {}; }
+			return std::string_view(reinterpret_cast<const char*>(this->data + p + 4), length);
+		}
 
-	std::vector<double> diff(const std::string& name, size_t from = 0, size_t length = 0) const
-	{
-		if (name.empty())
+		s_vector vector(size_t id) const
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return {};
+			uint32_t count = 0;
+			const size_t p = this->target(id);
+			if (!p || !read(this->data, this->size, p, count) || count > this->size - p - 4) { return {}; }
+			return { this->data, this->size, p + 4, count };
 		}
+	};
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return {}; }
+	inline s_table s_vector::table(size_t i) const
+	{
+		uint32_t offset = 0;
+		const size_t p = this->pos + i * 4;
+		if (i >= this->count || !read(this->data, this->size, p, offset) || offset > this->size - p) { return {}; }
+		return { this->data, this->size, p + offset };
+	}
 
-		const auto& col = it->second;
+	inline s_table root(const uint8_t* data, size_t size)
+	{
+		uint32_t offset = 0;
+		if (!read(data, size, 0, offset) || offset >= size) { return {}; }
+		return { data, size, offset };
+	}
 
-		const size_t n = col.size();
-		if (n == 0) { return {}; }
+	class c_builder
+	{
+	private:
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return {}; }
+		std::vector<uint8_t> m_buffer;
 
-		std::vector<double> vals;
-		vals.reserve(length);
-		for (size_t i = from; i < from + length; ++i)
+		struct s_field
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
+			uint16_t id = 0;
+			uint8_t bytes = 0;
+			uint64_t value = 0;
+			bool offset = false;
+		};
 
-			if (std::holds_alternative<double>(col[i]))
-			{
-				d = std::get<double>(col[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
-			}
+		std::vector<s_field> m_fields;
+		std::vector<std::pair<uint16_t, size_t>> m_slots;
 
-			if (!std::isnan(d))
-			{
-				vals.emplace_back(d);
-			}
+		void _pad(size_t align)
+		{
+			while (this->m_buffer.size() % align) { this->m_buffer.push_back(0); }
 		}
 
-		std::vector<double> diffs = n_math::first_diff(vals);
-		diffs.insert(diffs.begin(), std::numeric_limits<double>::quiet_NaN());
-
-		return diffs;
-	}
-
-	std::vector<double> diff(const std::string& name1, const std::string& name2, size_t from = 0, size_t length = 0) const
-	{
-		if (name1.empty() || name2.empty())
+		template<class t>
+		void _put(size_t pos, t v)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return {};
+			std::memcpy(this->m_buffer.data() + pos, &v, sizeof(t));
 		}
 
-		auto it1 = this->m_data.find(name1);
-		if (it1 == this->m_data.end()) { return {}; }
-
-		auto it2 = this->m_data.find(name2);
-		if (it2 == this->m_data.end()) { return {}; }
+	public:
 
-		const auto& col1 = it1->second;
-		const auto& col2 = it2->second;
+		/*
+		*	the root uoffset is written first and patched by finish()
+		*/
+		c_builder() : m_buffer(4, 0) {}
 
-		const size_t n = col1.size();
-		if (n == 0) { return {}; }
+		template<class t>
+		void add(uint16_t id, t v)
+		{
+			s_field f;
+			f.id = id;
+			f.bytes = static_cast<uint8_t>(sizeof(t));
+			std::memcpy(&f.value, &v, sizeof(t));
+			this->m_fields.push_back(f);
+		}
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return {}; }
+		/*
+		*	reserves a uoffset field; end_table() reports where it landed so it can be patched once the child is written
+		*/
+		void add_offset(uint16_t id)
+		{
+			s_field f;
+			f.id = id;
+			f.bytes = 4;
+			f.offset = true;
+			this->m_fields.push_back(f);
+		}
 
-		std::vector<double> vals;
-		vals.reserve(length);
-		for (size_t i = from; i < from + length; ++i)
+		/*
+		*	writes the vtable then the table (fields packed largest first) and returns the table position
+		*/
+		size_t end_table()
 		{
-			double d1 = std::numeric_limits<double>::quiet_NaN();
-			double d2 = std::numeric_limits<double>::quiet_NaN();
+			uint16_t fields = 0;
+			for (const auto& f : this->m_fields) { fields = std::max<uint16_t>(fields, f.id + 1); }
 
-			if (std::holds_alternative<double>(col1[i]))
-			{
-				d1 = std::get<double>(col1[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col1[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d1 = *parsed;
-			}
+			std::stable_sort(this->m_fields.begin(), this->m_fields.end(), [](const s_field& a, const s_field& b) { return a.bytes > b.bytes; });
 
-			if (std::holds_alternative<double>(col2[i]))
+			std::vector<uint16_t> offsets(fields, 0);
+			size_t inline_size = 4;
+			for (const auto& f : this->m_fields)
 			{
-				d2 = std::get<double>(col2[i]);
+				inline_size = (inline_size + f.bytes - 1) / f.bytes * f.bytes;
+				offsets[f.id] = static_cast<uint16_t>(inline_size);
+				inline_size += f.bytes;
 			}
-			else
+			inline_size = (inline_size + 3) / 4 * 4;
+
+			this->_pad(2);
+			const size_t vtable = this->m_buffer.size();
+			this->m_buffer.resize(vtable + 4 + 2 * fields, 0);
+			this->_put(vtable, static_cast<uint16_t>(4 + 2 * fields));
+			this->_put(vtable + 2, static_cast<uint16_t>(inline_size));
+			for (uint16_t i = 0; i < fields; ++i) { this->_put(vtable + 4 + 2 * i, offsets[i]); }
+
+			this->_pad(8);
+			const size_t table = this->m_buffer.size();
+			this->m_buffer.resize(table + inline_size, 0);
+			this->_put(table, static_cast<int32_t>(table - vtable));
+
+			this->m_slots.clear();
+			for (const auto& f : this->m_fields)
 			{
-				const std::string& s = std::get<std::string>(col2[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d2 = *parsed;
+				std::memcpy(this->m_buffer.data() + table + offsets[f.id], &f.value, f.bytes);
+				if (f.offset) { this->m_slots.emplace_back(f.id, table + offsets[f.id]); }
 			}
 
-			if (!std::isnan(d1) && !std::isnan(d2))
+			this->m_fields.clear();
+			return table;
+		}
+
+		/*
+		*	position of the uoffset reserved for field id by the last end_table()
+		*/
+		size_t slot(uint16_t id) const
+		{
+			for (const auto& [i, pos] : this->m_slots)
 			{
-				vals.emplace_back(d1 - d2);
+				if (i == id) { return pos; }
 			}
+			return 0;
 		}
 
-		return vals;
-	}
-
-	std::vector<double> pct_change(const std::string& name, size_t from = 0, size_t length = 0) const
-	{
-		if (name.empty())
+		void patch(size_t slot, size_t target)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return {};
+			this->_put(slot, static_cast<uint32_t>(target - slot));
 		}
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return {}; }
+		size_t add_string(std::string_view sv)
+		{
+			this->_pad(4);
+			const size_t pos = this->m_buffer.size();
+			this->m_buffer.resize(pos + 4 + sv.size() + 1, 0);
+			this->_put(pos, static_cast<uint32_t>(sv.size()));
+			if (!sv.empty()) { std::memcpy(this->m_buffer.data() + pos + 4, sv.data(), sv.size()); }
+			return pos;
+		}
 
-		const auto& col = it->second;
+		/*
+		*	vector of inline structs; the elements start 8-byte aligned
+		*/
+		size_t add_structs(const void* data, size_t count, size_t bytes)
+		{
+			while ((this->m_buffer.size() + 4) % 8) { this->m_buffer.push_back(0); }
+			const size_t pos = this->m_buffer.size();
+			this->m_buffer.resize(pos + 4, 0);
+			this->_put(pos, static_cast<uint32_t>(count));
+			if (count) { this->m_buffer.insert(this->m_buffer.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + count * bytes); }
+			return pos;
+		}
 
-		const size_t n = col.size();
-		if (n == 0) { return {}; }
+		/*
+		*	vector of uoffsets to tables; element i is patched through slot pos + 4 + 4 * i
+		*/
+		size_t add_offsets(size_t count)
+		{
+			this->_pad(4);
+			const size_t pos = this->m_buffer.size();
+			this->m_buffer.resize(pos + 4 + 4 * count, 0);
+			this->_put(pos, static_cast<uint32_t>(count));
+			return pos;
+		}
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return {}; }
+		const std::vector<uint8_t>& finish(size_t root)
+		{
+			this->patch(0, root);
+			this->_pad(8);
+			return this->m_buffer;
+		}
+	};
+}
 
-		std::vector<double> vals;
-		vals.reserve(length);
-		for (size_t i = from; i < from + length; ++i)
+/*
+*	lz4 frame decoding (arrow LZ4_FRAME buffer compression); blocks are decoded into one contiguous output so linked blocks
+*	can reference earlier ones
+*/
+namespace n_lz4
+{
+	inline bool decode_block(const uint8_t* src, size_t size, uint8_t* dst, size_t& out, size_t capacity)
+	{
+		const uint8_t* ip = src;
+		const uint8_t* end = src + size;
+
+		while (ip < end)
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
+			const uint8_t token = *ip++;
 
-			if (std::holds_alternative<double>(col[i]))
+			size_t literals = token >> 4;
+			if (literals == 15)
 			{
-				d = std::get<double>(col[i]);
+				uint8_t b = 0;
+				do
+				{
+					if (ip >= end) { return false; }
+					b = *ip++;
+					literals += b;
+				} while (b == 255);
 			}
-			else
+
+			if (literals > static_cast<size_t>(end - ip) || literals > capacity - out) { return false; }
+			std::memcpy(dst + out, ip, literals);
+			ip += literals;
+			out += literals;
+
+			if (ip == end) { break; }
+			if (end - ip < 2) { return false; }
+
+			const size_t offset = ip[0] | (size_t(ip[1]) << 8);
+			ip += 2;
+			if (!offset || offset > out) { return false; }
+
+			size_t length = token & 15;
+			if (length == 15)
 			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
+				uint8_t b = 0;
+				do
+				{
+					if (ip >= end) { return false; }
+					b = *ip++;
+					length += b;
+				} while (b == 255);
 			}
+			length += 4;
+
+			if (length > capacity - out) { return false; }
+
+			uint8_t* op = dst + out;
+			const uint8_t* match = op - offset;
+			if (offset >= length) { std::memcpy(op, match, length); }
+			else { for (size_t i = 0; i < length; ++i) { op[i] = match[i]; } }
+			out += length;
+		}
+
+		return true;
+	}
+
+	/*
+	*	decodes one frame into exactly capacity bytes
+	*/
+	inline bool decode_frame(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity)
+	{
+		uint32_t magic = 0;
+		if (!n_flatbuffers::read(src, size, 0, magic) || magic != 0x184D2204 || size < 7) { return false; }
+
+		const uint8_t flags = src[4];
+		if ((flags >> 6) != 1) { return false; }
+
+		const bool block_checksum = (flags >> 4) & 1;
+		const bool content_size = (flags >> 3) & 1;
+		const bool dictionary = flags & 1;
+
+		size_t pos = 6 + (content_size ? 8 : 0) + (dictionary ? 4 : 0) + 1;
+		size_t out = 0;
+
+		while (true)
+		{
+			uint32_t block = 0;
+			if (!n_flatbuffers::read(src, size, pos, block)) { return false; }
+			pos += 4;
+			if (!block) { break; }
 
-			if (!std::isnan(d))
+			const size_t bytes = block & 0x7FFFFFFF;
+			if (bytes > size - pos) { return false; }
+
+			if (block >> 31)
 			{
-				vals.emplace_back(d);
+				if (bytes > capacity - out) { return false; }
+				std::memcpy(dst + out, src + pos, bytes);
+				out += bytes;
 			}
-		}
+			else if (!decode_block(src + pos, bytes, dst, out, capacity)) { return false; }
 
-		std::vector<double> changes = n_math::relative_change_vector(vals);
-		changes.insert(changes.begin(), std::numeric_limits<double>::quiet_NaN());
+			pos += bytes + (block_checksum ? 4 : 0);
+		}
 
-		return changes;
+		return out == capacity;
 	}
+}
 
-	std::vector<double> pct_change(const std::string& name1, const std::string& name2, size_t from = 0, size_t length = 0) const
+/*
+*	thrift compact protocol, as used by parquet metadata. the reader is bounds-checked and sets ok = false instead of throwing;
+*	callers read the fields they know and skip the rest
+*/
+namespace n_thrift
+{
+	enum e_type : uint8_t
 	{
-		if (name1.empty() || name2.empty())
+		stop = 0,
+		bool_true = 1,
+		bool_false = 2,
+		i8 = 3,
+		i16 = 4,
+		i32 = 5,
+		i64 = 6,
+		f64 = 7,
+		binary = 8,
+		list = 9,
+		set = 10,
+		map = 11,
+		structure = 12
+	};
+
+	struct s_reader
+	{
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		size_t pos = 0;
+		bool ok = true;
+		int depth = 0;
+
+		uint8_t byte()
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return {};
+			if (this->pos >= this->size) { this->ok = false; return 0; }
+			return this->data[this->pos++];
 		}
 
-		auto it1 = this->m_data.find(name1);
-		if (it1 == this->m_data.end()) { return {}; }
+		uint64_t varint()
+		{
+			uint64_t v = 0;
+			for (int shift = 0; shift < 64 && this->ok; shift += 7)
+			{
+				const uint8_t b = this->byte();
+				v |= uint64_t(b & 0x7F) << shift;
+				if (!(b & 0x80)) { return v; }
+			}
+			this->ok = false;
+			return 0;
+		}
 
-		auto it2 = this->m_data.find(name2);
-		if (it2 == this->m_data.end()) { return {}; }
+		int64_t integer(uint8_t type)
+		{
+			if (type == i8) { return static_cast<int8_t>(this->byte()); }
+			const uint64_t v = this->varint();
+			return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+		}
 
-		const auto& col1 = it1->second;
-		const auto& col2 = it2->second;
+		std::string_view string()
+		{
+			const uint64_t length = this->varint();
+			if (!this->ok || length > this->size - this->pos) { this->ok = false; return {}; }
 
-		const size_t n = col1.size();
-		if (n == 0) { return {}; }
+			std::string_view sv(reinterpret_cast<const char*>(this->data + this->pos), static_cast<size_t>(length));
+			this->pos += static_cast<size_t>(length);
+			return sv;
+		}
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return {}; }
+		/*
+		*	calls fn(element type) once per element; fn consumes the element
+		*/
+		template<class fn_t>
+		void list(fn_t&& fn)
+		{
+			const uint8_t header = this->byte();
+			uint64_t count = header >> 4;
+			if (count == 15) { count = this->varint(); }
 
-		std::vector<double> vals;
-		vals.reserve(length);
-		for (size_t i = from; i < from + length; ++i)
+			for (uint64_t i = 0; i < count && this->ok; ++i) { fn(static_cast<uint8_t>(header & 0x0F)); }
+		}
+
+		/*
+		*	calls fn(field id, type) per field until the stop byte; fn consumes the value or calls skip(type)
+		*/
+		template<class fn_t>
+		void structure(fn_t&& fn)
 		{
-			double d1 = std::numeric_limits<double>::quiet_NaN();
-			double d2 = std::numeric_limits<double>::quiet_NaN();
+			if (++this->depth > 64) { this->ok = false; }
 
-			if (std::holds_alternative<double>(col1[i]))
+			int16_t id = 0;
+			while (this->ok)
 			{
-				d1 = std::get<double>(col1[i]);
+				const uint8_t header = this->byte();
+				const uint8_t type = header & 0x0F;
+				if (type == stop) { break; }
+
+				const uint8_t delta = header >> 4;
+				id = delta ? static_cast<int16_t>(id + delta) : static_cast<int16_t>(this->integer(i16));
+				fn(id, type);
 			}
-			else
+
+			--this->depth;
+		}
+
+		void skip(uint8_t type)
+		{
+			switch (type)
+			{
+			case bool_true: case bool_false: return;
+			case i8: this->byte(); return;
+			case i16: case i32: case i64: this->varint(); return;
+			case f64: this->pos += 8; if (this->pos > this->size) { this->ok = false; } return;
+			case binary: this->string(); return;
+			case n_thrift::list: case set:
+			{
+				if (++this->depth > 64) { this->ok = false; }
+				if (this->ok) { this->list([this](uint8_t t) { (t == bool_true || t == bool_false) ? (void)this->byte() : this->skip(t); }); }
+				--this->depth;
+				return;
+			}
+			case map:
 			{
-				const std::string& s = std::get<std::string>(col1[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d1 = *parsed;
+				if (++this->depth > 64) { this->ok = false; }
+				const uint64_t count = this->ok ? this->varint() : 0;
+				const uint8_t types = count ? this->byte() : 0;
+				for (uint64_t i = 0; i < count && this->ok; ++i)
+				{
+					this->skip(types >> 4);
+					this->skip(types & 0x0F);
+				}
+				--this->depth;
+				return;
 			}
+			case n_thrift::structure: this->structure([this](int16_t, uint8_t t) { this->skip(t); }); return;
+			default: this->ok = false; return;
+			}
+		}
+	};
 
-			if (std::holds_alternative<double>(col2[i]))
+	class c_writer
+	{
+	private:
+
+		std::vector<uint8_t> m_buffer;
+		std::vector<int16_t> m_ids = { 0 };
+
+		void _varint(uint64_t v)
+		{
+			while (v >= 0x80)
 			{
-				d2 = std::get<double>(col2[i]);
+				this->m_buffer.push_back(static_cast<uint8_t>(v | 0x80));
+				v >>= 7;
 			}
+			this->m_buffer.push_back(static_cast<uint8_t>(v));
+		}
+
+		void _zigzag(int64_t v)
+		{
+			this->_varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+		}
+
+	public:
+
+		void field(int16_t id, uint8_t type)
+		{
+			const int16_t delta = static_cast<int16_t>(id - this->m_ids.back());
+			if (delta > 0 && delta <= 15) { this->m_buffer.push_back(static_cast<uint8_t>((delta << 4) | type)); }
 			else
 			{
-				const std::string& s = std::get<std::string>(col2[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d2 = *parsed;
+				this->m_buffer.push_back(type);
+				this->_zigzag(id);
 			}
+			this->m_ids.back() = id;
+		}
+
+		void i32(int16_t id, int32_t v)
+		{
+			this->field(id, n_thrift::i32);
+			this->_zigzag(v);
+		}
+
+		void i64(int16_t id, int64_t v)
+		{
+			this->field(id, n_thrift::i64);
+			this->_zigzag(v);
+		}
+
+		void binary(int16_t id, std::string_view v)
+		{
+			this->field(id, n_thrift::binary);
+			this->value(v);
+		}
+
+		void value(std::string_view v)
+		{
+			this->_varint(v.size());
+			this->m_buffer.insert(this->m_buffer.end(), v.begin(), v.end());
+		}
 
-			if (!std::isnan(d1) && !std::isnan(d2))
+		void value(int64_t v)
+		{
+			this->_zigzag(v);
+		}
+
+		void list(int16_t id, uint8_t type, size_t count)
+		{
+			this->field(id, n_thrift::list);
+			if (count < 15) { this->m_buffer.push_back(static_cast<uint8_t>((count << 4) | type)); }
+			else
 			{
-				vals.emplace_back(n_math::relative_change(d1, d2));
+				this->m_buffer.push_back(static_cast<uint8_t>(0xF0 | type));
+				this->_varint(count);
 			}
 		}
 
-		return vals;
-	}
+		/*
+		*	begin() without an id starts a list element
+		*/
+		void begin(int16_t id)
+		{
+			this->field(id, n_thrift::structure);
+			this->begin();
+		}
 
-	std::vector<double> log_change(const std::string& name, size_t from = 0, size_t length = 0) const
-	{
-		if (name.empty())
+		void begin()
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return {};
+			this->m_ids.push_back(0);
 		}
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return {}; }
+		void end()
+		{
+			this->m_buffer.push_back(stop);
+			this->m_ids.pop_back();
+		}
 
-		const auto& col = it->second;
+		std::vector<uint8_t>& buffer() noexcept
+		{
+			return this->m_buffer;
+		}
+	};
+}
 
-		const size_t n = col.size();
-		if (n == 0) { return {}; }
+/*
+*	snappy raw blocks (parquet SNAPPY): a varint uncompressed length followed by literal and copy elements
+*/
+namespace n_snappy
+{
+	inline bool decode(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity)
+	{
+		n_thrift::s_reader header{ src, size };
+		if (header.varint() != capacity || !header.ok) { return false; }
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return {}; }
+		const uint8_t* ip = src + header.pos;
+		const uint8_t* end = src + size;
+		size_t out = 0;
 
-		std::vector<double> vals;
-		vals.reserve(length);
-		for (size_t i = from; i < from + length; ++i)
+		while (ip < end)
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
+			const uint8_t tag = *ip++;
+			size_t length = 0, offset = 0;
 
-			if (std::holds_alternative<double>(col[i]))
+			switch (tag & 3)
 			{
-				d = std::get<double>(col[i]);
+			case 0:
+			{
+				length = tag >> 2;
+				if (length >= 60)
+				{
+					const size_t bytes = length - 59;
+					if (static_cast<size_t>(end - ip) < bytes) { return false; }
+					length = 0;
+					for (size_t i = 0; i < bytes; ++i) { length |= size_t(ip[i]) << (8 * i); }
+					ip += bytes;
+				}
+				length += 1;
+
+				if (length > static_cast<size_t>(end - ip) || length > capacity - out) { return false; }
+				std::memcpy(dst + out, ip, length);
+				ip += length;
+				out += length;
+				continue;
 			}
-			else
+			case 1:
+				if (ip >= end) { return false; }
+				length = ((tag >> 2) & 7) + 4;
+				offset = (size_t(tag >> 5) << 8) | *ip++;
+				break;
+			case 2:
+				if (end - ip < 2) { return false; }
+				length = (tag >> 2) + 1;
+				offset = ip[0] | (size_t(ip[1]) << 8);
+				ip += 2;
+				break;
+			default:
+				if (end - ip < 4) { return false; }
+				length = (tag >> 2) + 1;
+				offset = ip[0] | (size_t(ip[1]) << 8) | (size_t(ip[2]) << 16) | (size_t(ip[3]) << 24);
+				ip += 4;
+				break;
+			}
+
+			if (!offset || offset > out || length > capacity - out) { return false; }
+
+			uint8_t* op = dst + out;
+			const uint8_t* match = op - offset;
+			if (offset >= length) { std::memcpy(op, match, length); }
+			else { for (size_t i = 0; i < length; ++i) { op[i] = match[i]; } }
+			out += length;
+		}
+
+		return out == capacity;
+	}
+
+	/*
+	*	greedy single-probe hash matcher over 64 KiB blocks, skipping faster through data that does not compress
+	*/
+	inline void encode(const uint8_t* src, size_t size, std::vector<uint8_t>& out)
+	{
+		out.clear();
+		for (uint64_t v = size; ; v >>= 7)
+		{
+			out.push_back(static_cast<uint8_t>(v >= 0x80 ? (v | 0x80) : v));
+			if (v < 0x80) { break; }
+		}
+
+		auto literal = [&](const uint8_t* p, size_t n) {
+			while (n)
 			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
+				const size_t k = std::min<size_t>(n, size_t(1) << 16);
+				const size_t m = k - 1;
+				if (m < 60) { out.push_back(static_cast<uint8_t>(m << 2)); }
+				else if (m < 256) { out.push_back(60 << 2); out.push_back(static_cast<uint8_t>(m)); }
+				else { out.push_back(61 << 2); out.push_back(static_cast<uint8_t>(m)); out.push_back(static_cast<uint8_t>(m >> 8)); }
+				out.insert(out.end(), p, p + k);
+				p += k;
+				n -= k;
 			}
+			};
+
+		auto load = [](const uint8_t* p) {
+			uint32_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+			};
+
+		constexpr size_t block_size = size_t(1) << 16;
+		std::vector<uint16_t> table(size_t(1) << 14);
+
+		for (size_t block = 0; block < size; block += block_size)
+		{
+			const uint8_t* base = src + block;
+			const size_t n = std::min(block_size, size - block);
+			std::fill(table.begin(), table.end(), uint16_t(0));
 
-			if (!std::isnan(d))
+			size_t ip = 1, pending = 0, skip = 32;
+			while (n >= 4 && ip + 4 <= n)
 			{
-				vals.emplace_back(d);
+				const uint32_t v = load(base + ip);
+				const uint32_t h = (v * 0x1E35A7BDu) >> 18;
+				const size_t candidate = table[h];
+				table[h] = static_cast<uint16_t>(ip);
+
+				if (load(base + candidate) != v)
+				{
+					ip += skip++ >> 5;
+					continue;
+				}
+
+				literal(base + pending, ip - pending);
+
+				size_t length = 4;
+				while (ip + length < n && base[candidate + length] == base[ip + length]) { ++length; }
+
+				const size_t offset = ip - candidate;
+				for (size_t left = length; left;)
+				{
+					const size_t k = std::min<size_t>(left, 64);
+					out.push_back(static_cast<uint8_t>(((k - 1) << 2) | 2));
+					out.push_back(static_cast<uint8_t>(offset));
+					out.push_back(static_cast<uint8_t>(offset >> 8));
+					left -= k;
+				}
+
+				ip += length;
+				pending = ip;
+				skip = 32;
 			}
+
+			literal(base + pending, n - pending);
 		}
+	}
+}
+
+/*
+*	read-only view over a contiguous buffer, handed to const c_column::visit for columns backed by external memory
+*/
+template<class t>
+struct s_span
+{
+	using value_type = t;
+
+	const t* ptr = nullptr;
+	size_t count = 0;
+
+	size_t size() const noexcept { return this->count; }
+	bool empty() const noexcept { return !this->count; }
+	const t* data() const noexcept { return this->ptr; }
+	const t* begin() const noexcept { return this->ptr; }
+	const t* end() const noexcept { return this->ptr + this->count; }
+	const t& operator[](size_t i) const noexcept { return this->ptr[i]; }
+};
 
-		std::vector<double> changes = n_math::log_relative_change_vector(vals);
-		changes.insert(changes.begin(), std::numeric_limits<double>::quiet_NaN());
+/*
+*	statistics of one column keyed by (stat, from, length) and tagged with the column version they were computed at. a
+*	copy starts empty, and lookups are locked so const reductions may run concurrently
+*/
+class c_stat_cache
+{
+private:
+
+	struct s_entry
+	{
+		uint8_t stat = 0;
+		size_t from = 0;
+		size_t length = 0;
+		uint64_t version = 0;
+		double value = 0.0;
+	};
+
+	mutable std::mutex m_mutex;
+	mutable std::vector<s_entry> m_entries;
+
+	static constexpr size_t _max_entries = 64;
 
-		return changes;
+public:
+
+	c_stat_cache() = default;
+
+	c_stat_cache(const c_stat_cache&) noexcept {}
+
+	c_stat_cache& operator=(const c_stat_cache&)
+	{
+		this->clear();
+		return *this;
 	}
 
-	std::vector<double> log_change(const std::string& name1, const std::string& name2, size_t from = 0, size_t length = 0) const
+	bool find(uint8_t stat, size_t from, size_t length, uint64_t version, double& value) const
 	{
-		if (name1.empty() || name2.empty())
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		for (const auto& e : this->m_entries)
 		{
-			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
-			return {};
+			if (e.stat == stat && e.from == from && e.length == length && e.version == version)
+			{
+				value = e.value;
+				return true;
+			}
 		}
+		return false;
+	}
 
-		auto it1 = this->m_data.find(name1);
-		if (it1 == this->m_data.end()) { return {}; }
+	/*
+	*	entries of older versions are dropped first, then the oldest entry once the cache is full
+	*/
+	void store(uint8_t stat, size_t from, size_t length, uint64_t version, double value) const
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_entries.erase(std::remove_if(this->m_entries.begin(), this->m_entries.end(),
+			[version](const s_entry& e) { return e.version != version; }), this->m_entries.end());
+		if (this->m_entries.size() >= _max_entries) { this->m_entries.erase(this->m_entries.begin()); }
 
-		auto it2 = this->m_data.find(name2);
-		if (it2 == this->m_data.end()) { return {}; }
+		this->m_entries.push_back({ stat, from, length, version, value });
+	}
 
-		const auto& col1 = it1->second;
-		const auto& col2 = it2->second;
+	void clear() const
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->m_entries.clear();
+	}
 
-		const size_t n = col1.size();
-		if (n == 0) { return {}; }
+	size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		return this->m_entries.size();
+	}
+};
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return {}; }
+/*
+*	opt-in index over the values of a numeric column answering sum, var, min and max of any row range in O(1): compensated
+*	prefix sums of x - shift and (x - shift)^2 over the finite values, prefix counts of the non-NaN values and of the
+*	infinities, and a sparse table over the min / max of each _block values (a range scans at most two partial blocks).
+*	appending values extends it in place; it answers for the column version it was last built or extended at
+*/
+class c_range_index
+{
+private:
 
-		std::vector<double> vals;
-		vals.reserve(length);
-		for (size_t i = from; i < from + length; ++i)
+	static constexpr size_t _block = 64;
+
+	uint64_t m_version = 0;
+	size_t m_size = 0;
+	double m_shift = 0.0;
+	bool m_shifted = false;
+
+	std::vector<double> m_sum;
+	std::vector<double> m_sum_err;
+	std::vector<double> m_sq;
+	std::vector<double> m_sq_err;
+	std::vector<size_t> m_count;
+	std::vector<size_t> m_pos_inf;
+	std::vector<size_t> m_neg_inf;
+
+	/*
+	*	level k holds the min / max of the 2^k complete blocks starting at each block
+	*/
+	std::vector<std::vector<double>> m_min;
+	std::vector<std::vector<double>> m_max;
+	double m_block_min = std::numeric_limits<double>::infinity();
+	double m_block_max = -std::numeric_limits<double>::infinity();
+
+	struct s_range
+	{
+		size_t count = 0;
+		size_t pos_inf = 0;
+		size_t neg_inf = 0;
+		double sum = 0.0;
+		double sq = 0.0;
+	};
+
+	static void _kahan(double& sum, double& err, double x)
+	{
+		const double y = x - err;
+		const double t = sum + y;
+		err = (t - sum) - y;
+		sum = t;
+	}
+
+	s_range _range(size_t a, size_t b) const
+	{
+		s_range r;
+		r.count = this->m_count[b] - this->m_count[a];
+		r.pos_inf = this->m_pos_inf[b] - this->m_pos_inf[a];
+		r.neg_inf = this->m_neg_inf[b] - this->m_neg_inf[a];
+		r.sum = (this->m_sum[b] - this->m_sum[a]) - (this->m_sum_err[b] - this->m_sum_err[a]);
+		r.sq = (this->m_sq[b] - this->m_sq[a]) - (this->m_sq_err[b] - this->m_sq_err[a]);
+		return r;
+	}
+
+	void _push_block()
+	{
+		if (this->m_min.empty())
 		{
-			double d1 = std::numeric_limits<double>::quiet_NaN();
-			double d2 = std::numeric_limits<double>::quiet_NaN();
+			this->m_min.emplace_back();
+			this->m_max.emplace_back();
+		}
+
+		this->m_min[0].push_back(this->m_block_min);
+		this->m_max[0].push_back(this->m_block_max);
+		this->m_block_min = std::numeric_limits<double>::infinity();
+		this->m_block_max = -std::numeric_limits<double>::infinity();
 
-			if (std::holds_alternative<double>(col1[i]))
+		const size_t blocks = this->m_min[0].size();
+		for (size_t k = 1; (size_t(1) << k) <= blocks; ++k)
+		{
+			if (this->m_min.size() == k)
 			{
-				d1 = std::get<double>(col1[i]);
+				this->m_min.emplace_back();
+				this->m_max.emplace_back();
 			}
-			else
+
+			const size_t j = blocks - (size_t(1) << k);
+			const size_t half = size_t(1) << (k - 1);
+			this->m_min[k].push_back(std::min(this->m_min[k - 1][j], this->m_min[k - 1][j + half]));
+			this->m_max[k].push_back(std::max(this->m_max[k - 1][j], this->m_max[k - 1][j + half]));
+		}
+	}
+
+	/*
+	*	whole blocks inside [a, b) come from the table, the partial blocks at either end are scanned in values
+	*/
+	template<class values_t, class pick_t>
+	double _extreme(const values_t& values, size_t a, size_t b, const std::vector<std::vector<double>>& table, double init, pick_t&& pick) const
+	{
+		double r = init;
+		auto scan = [&](size_t from, size_t to) {
+			for (size_t i = from; i < to; ++i)
 			{
-				const std::string& s = std::get<std::string>(col1[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d1 = *parsed;
+				const double x = static_cast<double>(values[i]);
+				if (!std::isnan(x)) { r = pick(r, x); }
 			}
+			};
+
+		const size_t first = (a + _block - 1) / _block;
+		const size_t last = b / _block;
+		if (first >= last)
+		{
+			scan(a, b);
+			return r;
+		}
+
+		scan(a, first * _block);
+		scan(last * _block, b);
+
+		const size_t k = n_simd::msb(last - first);
+		r = pick(r, pick(table[k][first], table[k][last - (size_t(1) << k)]));
+		return r;
+	}
+
+public:
+
+	uint64_t version() const noexcept
+	{
+		return this->m_version;
+	}
+
+	void set_version(uint64_t version) noexcept
+	{
+		this->m_version = version;
+	}
+
+	size_t size() const noexcept
+	{
+		return this->m_size;
+	}
+
+	template<class t>
+	void append(const t* p, size_t k)
+	{
+		if (this->m_count.empty())
+		{
+			this->m_sum.push_back(0.0);
+			this->m_sum_err.push_back(0.0);
+			this->m_sq.push_back(0.0);
+			this->m_sq_err.push_back(0.0);
+			this->m_count.push_back(0);
+			this->m_pos_inf.push_back(0);
+			this->m_neg_inf.push_back(0);
+		}
 
-			if (std::holds_alternative<double>(col2[i]))
+		const size_t base = this->m_size;
+		double sum = this->m_sum[base], sum_err = this->m_sum_err[base];
+		double sq = this->m_sq[base], sq_err = this->m_sq_err[base];
+		size_t count = this->m_count[base], pos_inf = this->m_pos_inf[base], neg_inf = this->m_neg_inf[base];
+
+		this->m_sum.resize(base + k + 1);
+		this->m_sum_err.resize(base + k + 1);
+		this->m_sq.resize(base + k + 1);
+		this->m_sq_err.resize(base + k + 1);
+		this->m_count.resize(base + k + 1);
+		this->m_pos_inf.resize(base + k + 1);
+		this->m_neg_inf.resize(base + k + 1);
+
+		for (size_t i = 0; i < k; ++i)
+		{
+			const double x = static_cast<double>(p[i]);
+			if (!std::isnan(x))
 			{
-				d2 = std::get<double>(col2[i]);
-			}
+				++count;
+				if (std::isinf(x)) { ++(x > 0 ? pos_inf : neg_inf); }
+				else
+				{
+					if (!this->m_shifted)
+					{
+						this->m_shift = x;
+						this->m_shifted = true;
+					}
+
+					const double d = x - this->m_shift;
+					_kahan(sum, sum_err, d);
+					_kahan(sq, sq_err, d * d);
+				}
+
+				this->m_block_min = std::min(this->m_block_min, x);
+				this->m_block_max = std::max(this->m_block_max, x);
+			}
+
+			const size_t j = base + i + 1;
+			this->m_sum[j] = sum;
+			this->m_sum_err[j] = sum_err;
+			this->m_sq[j] = sq;
+			this->m_sq_err[j] = sq_err;
+			this->m_count[j] = count;
+			this->m_pos_inf[j] = pos_inf;
+			this->m_neg_inf[j] = neg_inf;
+
+			if (++this->m_size % _block == 0) { this->_push_block(); }
+		}
+	}
+
+	/*
+	*	the reductions below match c_dataframe's: NaN values are skipped, var divides by the rows in the range minus one
+	*/
+	double sum(size_t a, size_t b) const
+	{
+		const s_range r = this->_range(a, b);
+		if (r.pos_inf && r.neg_inf) { return std::numeric_limits<double>::quiet_NaN(); }
+		if (r.pos_inf) { return std::numeric_limits<double>::infinity(); }
+		if (r.neg_inf) { return -std::numeric_limits<double>::infinity(); }
+		return r.count ? r.sum + this->m_shift * static_cast<double>(r.count) : 0.0;
+	}
+
+	double var(size_t a, size_t b) const
+	{
+		const size_t length = b - a;
+		if (length < 2) { return 0.0; }
+
+		const s_range r = this->_range(a, b);
+		if (r.pos_inf || r.neg_inf) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		const double m2 = r.count ? std::max(0.0, r.sq - r.sum * r.sum / static_cast<double>(r.count)) : 0.0;
+		return m2 / static_cast<double>(length - 1);
+	}
+
+	template<class values_t>
+	double min(const values_t& values, size_t a, size_t b) const
+	{
+		return this->_extreme(values, a, b, this->m_min, std::numeric_limits<double>::infinity(), [](double x, double y) { return y < x ? y : x; });
+	}
+
+	template<class values_t>
+	double max(const values_t& values, size_t a, size_t b) const
+	{
+		return this->_extreme(values, a, b, this->m_max, -std::numeric_limits<double>::infinity(), [](double x, double y) { return y > x ? y : x; });
+	}
+};
+
+/*
+*	one contiguous, typed buffer per column; booleans are stored as uint8_t so every numeric column is addressable as a plain array
+*/
+class c_column
+{
+private:
+
+	std::variant<std::vector<double>, std::vector<int64_t>, std::vector<uint8_t>, std::vector<std::string>> m_values;
+
+	/*
+	*	numeric columns may reference external memory (a mapped file) kept alive by m_owner instead of m_values
+	*/
+	const void* m_view = nullptr;
+	size_t m_view_size = 0;
+	std::shared_ptr<const void> m_owner;
+
+	/*
+	*	bumped by every mutable access to the values; c_dataframe caches statistics in m_stats against it
+	*/
+	uint64_t m_version = 0;
+	c_stat_cache m_stats;
+	std::shared_ptr<c_range_index> m_index;
+
+	void _detach()
+	{
+		if (!this->m_view) { return; }
+
+		std::visit([this](auto& v) {
+			using t = typename std::decay_t<decltype(v)>::value_type;
+			if constexpr (!std::is_same_v<t, std::string>)
+			{
+				const t* p = static_cast<const t*>(this->m_view);
+				v.assign(p, p + this->m_view_size);
+			}
+			}, this->m_values);
+
+		this->m_view = nullptr;
+		this->m_view_size = 0;
+		this->m_owner.reset();
+	}
+
+public:
+
+	c_column() = default;
+
+	explicit c_column(e_dtype type, size_t size = 0)
+	{
+		switch (type)
+		{
+		case e_dtype::f64: this->m_values = std::vector<double>(size); break;
+		case e_dtype::i64: this->m_values = std::vector<int64_t>(size); break;
+		case e_dtype::boolean: this->m_values = std::vector<uint8_t>(size); break;
+		case e_dtype::str: this->m_values = std::vector<std::string>(size); break;
+		}
+	}
+
+	explicit c_column(std::vector<double> values) : m_values(std::move(values)) {}
+
+	explicit c_column(std::vector<int64_t> values) : m_values(std::move(values)) {}
+
+	explicit c_column(std::vector<uint8_t> values) : m_values(std::move(values)) {}
+
+	explicit c_column(std::vector<std::string> values) : m_values(std::move(values)) {}
+
+	/*
+	*	numeric column over size values at data, kept alive by owner; the values are copied the first time the column is modified
+	*/
+	static c_column view(e_dtype type, const void* data, size_t size, std::shared_ptr<const void> owner)
+	{
+		c_column col(type);
+		if (type == e_dtype::str || !size) { return col; }
+
+		col.m_view = data;
+		col.m_view_size = size;
+		col.m_owner = std::move(owner);
+		return col;
+	}
+
+	bool is_view() const noexcept
+	{
+		return this->m_view != nullptr;
+	}
+
+	e_dtype type() const noexcept
+	{
+		return static_cast<e_dtype>(this->m_values.index());
+	}
+
+	bool is_numeric() const noexcept
+	{
+		return this->type() != e_dtype::str;
+	}
+
+	size_t size() const noexcept
+	{
+		if (this->m_view) { return this->m_view_size; }
+		return std::visit([](const auto& v) { return v.size(); }, this->m_values);
+	}
+
+	uint64_t version() const noexcept
+	{
+		return this->m_version;
+	}
+
+	/*
+	*	marks the column modified. mutable accesses do this themselves; it is only needed after writing through a reference
+	*	kept from before the last statistics call
+	*/
+	void touch() noexcept
+	{
+		++this->m_version;
+	}
+
+	const c_stat_cache& stats() const noexcept
+	{
+		return this->m_stats;
+	}
+
+	/*
+	*	the index built by c_dataframe::build_index, or nullptr once the column changed other than by c_dataframe::append
+	*/
+	const c_range_index* index() const noexcept
+	{
+		return this->m_index && this->m_index->version() == this->m_version ? this->m_index.get() : nullptr;
+	}
+
+	std::shared_ptr<c_range_index>& index_ptr() noexcept
+	{
+		return this->m_index;
+	}
+
+	template<class t>
+	std::vector<t>& values()
+	{
+		this->_detach();
+		++this->m_version;
+		return std::get<std::vector<t>>(this->m_values);
+	}
+
+	/*
+	*	owned storage without a version bump, for loaders writing disjoint rows from several threads; they touch() once after the join
+	*/
+	template<class t>
+	std::vector<t>& buffer()
+	{
+		return std::get<std::vector<t>>(this->m_values);
+	}
+
+	/*
+	*	drops the last n values; a view only shrinks its bounds, so trimming a mapped column never copies it
+	*/
+	void truncate(size_t n)
+	{
+		++this->m_version;
+		if (this->m_view)
+		{
+			this->m_view_size -= n;
+			return;
+		}
+
+		std::visit([n](auto& v) { v.resize(v.size() - n); }, this->m_values);
+	}
+
+	/*
+	*	string columns only, they are never views; numeric reads go through data<t>() or visit() so a const column stays safe
+	*	to read from several threads
+	*/
+	template<class t>
+	const std::vector<t>& values() const
+	{
+		static_assert(std::is_same_v<t, std::string>, "read numeric columns through data<t>() or visit()");
+		return std::get<std::vector<t>>(this->m_values);
+	}
+
+	template<class t>
+	const t* data() const
+	{
+		const auto& v = std::get<std::vector<t>>(this->m_values);
+		if (this->m_view) { return static_cast<const t*>(this->m_view); }
+		return v.data();
+	}
+
+	template<class fn_t>
+	decltype(auto) visit(fn_t&& fn)
+	{
+		this->_detach();
+		++this->m_version;
+		return std::visit(std::forward<fn_t>(fn), this->m_values);
+	}
+
+	/*
+	*	fn receives the values as const std::vector<t>&, or as s_span<t> when the column is a view
+	*/
+	template<class fn_t>
+	decltype(auto) visit(fn_t&& fn) const
+	{
+		if (this->m_view)
+		{
+			switch (this->type())
+			{
+			case e_dtype::i64: return fn(s_span<int64_t>{ static_cast<const int64_t*>(this->m_view), this->m_view_size });
+			case e_dtype::boolean: return fn(s_span<uint8_t>{ static_cast<const uint8_t*>(this->m_view), this->m_view_size });
+			default: return fn(s_span<double>{ static_cast<const double*>(this->m_view), this->m_view_size });
+			}
+		}
+
+		return std::visit(std::forward<fn_t>(fn), this->m_values);
+	}
+
+	static std::optional<double> parse_double(std::string_view sv)
+	{
+		if (sv.empty()) { return std::nullopt; }
+
+		auto eq = [&](std::string_view t) {
+			if (sv.size() != t.size()) { return false; }
+			for (size_t i = 0; i < sv.size(); ++i)
+			{
+				if ((char)std::tolower((unsigned char)sv[i]) != t[i]) { return false; }
+			}
+			return true;
+			};
+
+		if (eq("nan")) { return std::numeric_limits<double>::quiet_NaN(); }
+		if (eq("inf") || eq("+inf")) { return std::numeric_limits<double>::infinity(); }
+		if (eq("-inf")) { return -std::numeric_limits<double>::infinity(); }
+
+		double v = 0.0;
+		auto* b = sv.data(); auto* e = b + sv.size();
+		auto [p, ec] = std::from_chars(b, e, v);
+		if (ec == std::errc() && p == e) { return v; }
+
+		return std::nullopt;
+	}
+
+	static std::string format_double(double v)
+	{
+		char buf[64];
+		auto [p, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+		if (ec != std::errc()) { return {}; }
+		return std::string(buf, p);
+	}
+
+	value_t get(size_t index) const
+	{
+		return this->visit([index](const auto& v) -> value_t {
+
+			using t = typename std::decay_t<decltype(v)>::value_type;
+
+			if constexpr (std::is_same_v<t, std::string>) { return v[index]; }
+			else { return static_cast<double>(v[index]); }
+			});
+	}
+
+	void set(size_t index, const value_t& value)
+	{
+		this->visit([index, &value](auto& v) {
+
+			using t = typename std::decay_t<decltype(v)>::value_type;
+
+			if constexpr (std::is_same_v<t, std::string>)
+			{
+				v[index] = std::holds_alternative<std::string>(value) ? std::get<std::string>(value) : format_double(std::get<double>(value));
+			}
 			else
 			{
-				const std::string& s = std::get<std::string>(col2[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d2 = *parsed;
+				double d = std::numeric_limits<double>::quiet_NaN();
+				if (std::holds_alternative<double>(value)) { d = std::get<double>(value); }
+				else
+				{
+					auto parsed = parse_double(std::get<std::string>(value));
+					if (!parsed.has_value()) { throw std::runtime_error("c_column::set: non-numeric value for numeric column"); }
+					d = *parsed;
+				}
+
+				if constexpr (std::is_same_v<t, double>) { v[index] = d; }
+				else
+				{
+					if (!std::isfinite(d)) { throw std::runtime_error("c_column::set: non-finite value for integer column"); }
+					v[index] = static_cast<t>(d);
+				}
+			}
+			});
+	}
+
+	std::string to_string(size_t index) const
+	{
+		return this->visit([index](const auto& v) -> std::string {
+
+			using t = typename std::decay_t<decltype(v)>::value_type;
+
+			if constexpr (std::is_same_v<t, std::string>) { return v[index]; }
+			else if constexpr (std::is_same_v<t, double>)
+			{
+				std::ostringstream oss;
+				oss.imbue(std::locale::classic());
+				oss << v[index];
+				return oss.str();
+			}
+			else { return std::to_string(v[index]); }
+			});
+	}
+
+	void erase(size_t index)
+	{
+		this->visit([index](auto& v) { v.erase(v.begin() + index); });
+	}
+
+	void pop_back()
+	{
+		this->visit([](auto& v) { v.pop_back(); });
+	}
+
+	c_column slice(size_t from, size_t length) const
+	{
+		return this->visit([from, length](const auto& v) {
+			using t = typename std::decay_t<decltype(v)>::value_type;
+			return c_column(std::vector<t>(v.begin() + from, v.begin() + from + length));
+			});
+	}
+};
+
+/*
+*	a double value compares numerically (blank or non-numeric values are NaN), a string value compares the text
+*/
+struct s_predicate
+{
+	std::string column;
+	e_compare op = e_compare::eq;
+	value_t value = 0.0;
+};
+
+struct s_csv_options
+{
+	bool header = true;
+	size_t infer_rows = 1000;							// rows sampled per column for type inference, 0 samples every row
+	std::unordered_map<std::string, e_dtype> schema;	// explicit column types by name (col_<i> without header), skips inference
+	std::vector<std::string> usecols;					// columns to load by name, empty loads every column
+	size_t skiprows = 0;								// data rows skipped after the header
+	size_t nrows = 0;									// data rows read after skiprows, 0 reads to the end of the file
+	std::vector<s_predicate> where;						// keeps only rows where every predicate holds
+};
+
+struct s_parquet_options
+{
+	std::vector<std::string> usecols;					// columns to load by name, empty loads every column
+	std::vector<s_predicate> where;						// keeps only rows where every predicate holds; row groups whose statistics rule it out are never read
+};
+
+enum class e_codec : uint8_t
+{
+	none,
+	snappy
+};
+
+/*
+*	describe(name): the values sum, mean, var, std, min, max, skew and kurt return for the same range, from one pass
+*/
+struct s_stats
+{
+	size_t count = 0;									// non-NaN values in the range
+	double sum = std::numeric_limits<double>::quiet_NaN();
+	double mean = std::numeric_limits<double>::quiet_NaN();
+	double var = std::numeric_limits<double>::quiet_NaN();
+	double std = std::numeric_limits<double>::quiet_NaN();
+	double min = std::numeric_limits<double>::quiet_NaN();	// +inf when count is 0, like min()
+	double max = std::numeric_limits<double>::quiet_NaN();	// -inf when count is 0, like max()
+	double skew = std::numeric_limits<double>::quiet_NaN();
+	double kurt = std::numeric_limits<double>::quiet_NaN();
+};
+
+enum class e_transform : uint8_t
+{
+	diff,
+	pct_change,
+	log_change,
+	cumsum,
+	cumprod
+};
+
+/*
+*	one bit per row, built by comparisons such as df.col("x") > 3.0 and combined with &, | and ~
+*/
+class c_mask
+{
+private:
+
+	std::vector<uint64_t> m_bits;
+	size_t m_size = 0;
+
+	void _trim() noexcept
+	{
+		if (this->m_size & 63) { this->m_bits.back() &= (uint64_t(1) << (this->m_size & 63)) - 1; }
+	}
+
+public:
+
+	c_mask() = default;
+
+	explicit c_mask(size_t size, bool value = false) : m_bits((size + 63) / 64, value ? ~uint64_t(0) : 0), m_size(size)
+	{
+		this->_trim();
+	}
+
+	explicit c_mask(const std::vector<bool>& values) : c_mask(values.size())
+	{
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			if (values[i]) { this->set(i); }
+		}
+	}
+
+	size_t size() const noexcept
+	{
+		return this->m_size;
+	}
+
+	size_t count() const noexcept
+	{
+		size_t n = 0;
+		for (uint64_t w : this->m_bits) { n += n_simd::popcount(w); }
+		return n;
+	}
+
+	bool test(size_t i) const noexcept
+	{
+		return (this->m_bits[i >> 6] >> (i & 63)) & 1;
+	}
+
+	void set(size_t i, bool value = true) noexcept
+	{
+		if (value) { this->m_bits[i >> 6] |= uint64_t(1) << (i & 63); }
+		else { this->m_bits[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+	}
+
+	uint64_t* words() noexcept
+	{
+		return this->m_bits.data();
+	}
+
+	const uint64_t* words() const noexcept
+	{
+		return this->m_bits.data();
+	}
+
+	/*
+	*	calls fn(i) for every set bit i in [from, to)
+	*/
+	template<class fn_t>
+	void for_each(size_t from, size_t to, fn_t&& fn) const
+	{
+		for (size_t w = from >> 6; (w << 6) < to; ++w)
+		{
+			uint64_t bits = this->m_bits[w];
+			if ((w << 6) < from) { bits &= ~uint64_t(0) << (from & 63); }
+			if ((w << 6) + 64 > to) { bits &= (uint64_t(1) << (to & 63)) - 1; }
+
+			while (bits)
+			{
+				fn((w << 6) + n_simd::ctz(bits));
+				bits &= bits - 1;
 			}
+		}
+	}
+
+	c_mask& operator&=(const c_mask& other)
+	{
+		if (other.m_size != this->m_size) { throw std::runtime_error("c_mask::operator&=: size mismatch"); }
+		for (size_t i = 0; i < this->m_bits.size(); ++i) { this->m_bits[i] &= other.m_bits[i]; }
+		return *this;
+	}
+
+	c_mask& operator|=(const c_mask& other)
+	{
+		if (other.m_size != this->m_size) { throw std::runtime_error("c_mask::operator|=: size mismatch"); }
+		for (size_t i = 0; i < this->m_bits.size(); ++i) { this->m_bits[i] |= other.m_bits[i]; }
+		return *this;
+	}
+
+	c_mask operator~() const
+	{
+		c_mask out = *this;
+		for (auto& w : out.m_bits) { w = ~w; }
+		out._trim();
+		return out;
+	}
+
+	friend c_mask operator&(c_mask a, const c_mask& b) { return a &= b; }
+
+	friend c_mask operator|(c_mask a, const c_mask& b) { return a |= b; }
+};
+
+/*
+*	mergeable t-digest (merging variant, k1 scale): approximate quantiles in O(compression) memory. values are buffered and
+*	folded into at most about compression centroids, small near the tails and large near the median; two digests merge by
+*	folding their centroids together, so a column can be sketched in parallel blocks and a sketch updated as values arrive
+*/
+class c_tdigest
+{
+private:
+
+	struct s_centroid
+	{
+		double mean = 0.0;
+		double weight = 0.0;
+	};
+
+	static constexpr size_t _buffer_factor = 5;
+
+	double m_compression = 100.0;
+	double m_weight = 0.0;
+	double m_min = std::numeric_limits<double>::infinity();
+	double m_max = -std::numeric_limits<double>::infinity();
+	std::vector<s_centroid> m_centroids;
+	std::vector<s_centroid> m_buffer;
+
+	/*
+	*	k1 scale function and its inverse; a centroid may span at most one unit of k
+	*/
+	double _k(double q) const
+	{
+		return this->m_compression / (2.0 * std::acos(-1.0)) * std::asin(2.0 * q - 1.0);
+	}
+
+	double _q(double k) const
+	{
+		if (k >= this->m_compression / 4.0) { return 1.0; }
+		return (std::sin(k * 2.0 * std::acos(-1.0) / this->m_compression) + 1.0) / 2.0;
+	}
+
+	void _compress()
+	{
+		if (this->m_buffer.empty()) { return; }
+
+		this->m_buffer.insert(this->m_buffer.end(), this->m_centroids.begin(), this->m_centroids.end());
+		std::sort(this->m_buffer.begin(), this->m_buffer.end(), [](const s_centroid& a, const s_centroid& b) {
+			return a.mean < b.mean || (a.mean == b.mean && a.weight < b.weight);
+			});
+
+		double total = 0.0;
+		for (const s_centroid& c : this->m_buffer) { total += c.weight; }
+
+		this->m_centroids.clear();
+		s_centroid cur = this->m_buffer[0];
+		double q0 = 0.0;
+		double limit = this->_q(this->_k(q0) + 1.0);
+
+		for (size_t i = 1; i < this->m_buffer.size(); ++i)
+		{
+			const s_centroid& c = this->m_buffer[i];
+			if (q0 + (cur.weight + c.weight) / total <= limit)
+			{
+				cur.weight += c.weight;
+				if (c.mean != cur.mean) { cur.mean += (c.mean - cur.mean) * c.weight / cur.weight; }
+				continue;
+			}
+
+			this->m_centroids.push_back(cur);
+			q0 += cur.weight / total;
+			limit = this->_q(this->_k(q0) + 1.0);
+			cur = c;
+		}
+
+		this->m_centroids.push_back(cur);
+		this->m_weight = total;
+		this->m_buffer.clear();
+	}
+
+	static double _between(double x1, double w1, double x2, double w2)
+	{
+		if (w1 + w2 <= 0.0) { return (x1 + x2) / 2.0; }
+		const double x = (x1 * w1 + x2 * w2) / (w1 + w2);
+		return std::max(std::min(x1, x2), std::min(x, std::max(x1, x2)));
+	}
+
+	/*
+	*	interpolates between centroid centers, treating weight-1 centroids as exact values and the outer halves of the
+	*	first and last centroids as running to the observed min / max
+	*/
+	double _quantile(double q) const
+	{
+		const std::vector<s_centroid>& c = this->m_centroids;
+		const double total = this->m_weight;
+		const double index = q * total;
+
+		if (c.size() == 1 && c[0].weight == 1.0) { return c[0].mean; }
+		if (index < 1.0) { return this->m_min; }
+		if (c[0].weight > 1.0 && index < c[0].weight / 2.0)
+		{
+			return this->m_min + (index - 1.0) / (c[0].weight / 2.0 - 1.0) * (c[0].mean - this->m_min);
+		}
+		if (index > total - 1.0) { return this->m_max; }
+		if (c.back().weight > 1.0 && total - index <= c.back().weight / 2.0)
+		{
+			return this->m_max - (total - index - 1.0) / (c.back().weight / 2.0 - 1.0) * (this->m_max - c.back().mean);
+		}
+
+		double so_far = c[0].weight / 2.0;
+		for (size_t i = 0; i + 1 < c.size(); ++i)
+		{
+			const double dw = (c[i].weight + c[i + 1].weight) / 2.0;
+			if (so_far + dw > index)
+			{
+				double left = 0.0;
+				if (c[i].weight == 1.0)
+				{
+					if (index - so_far < 0.5) { return c[i].mean; }
+					left = 0.5;
+				}
+
+				double right = 0.0;
+				if (c[i + 1].weight == 1.0)
+				{
+					if (so_far + dw - index <= 0.5) { return c[i + 1].mean; }
+					right = 0.5;
+				}
+
+				return _between(c[i].mean, so_far + dw - index - right, c[i + 1].mean, index - so_far - left);
+			}
+
+			so_far += dw;
+		}
+
+		const double z1 = index - total + c.back().weight / 2.0;
+		return _between(c.back().mean, c.back().weight / 2.0 - z1, this->m_max, z1);
+	}
+
+public:
+
+	explicit c_tdigest(double compression = 100.0) : m_compression(std::max(compression, 10.0)) {}
+
+	/*
+	*	NaN values are skipped
+	*/
+	void add(double x)
+	{
+		if (std::isnan(x)) { return; }
+
+		this->m_buffer.push_back({ x, 1.0 });
+		this->m_min = std::min(this->m_min, x);
+		this->m_max = std::max(this->m_max, x);
+		if (this->m_buffer.size() >= _buffer_factor * static_cast<size_t>(this->m_compression)) { this->_compress(); }
+	}
+
+	template<class t>
+	void add(const t* p, size_t k)
+	{
+		for (size_t i = 0; i < k; ++i) { this->add(static_cast<double>(p[i])); }
+	}
+
+	void merge(const c_tdigest& other)
+	{
+		if (!other.count()) { return; }
+
+		this->m_buffer.insert(this->m_buffer.end(), other.m_centroids.begin(), other.m_centroids.end());
+		this->m_buffer.insert(this->m_buffer.end(), other.m_buffer.begin(), other.m_buffer.end());
+		this->m_min = std::min(this->m_min, other.m_min);
+		this->m_max = std::max(this->m_max, other.m_max);
+		this->_compress();
+	}
+
+	size_t count() const noexcept
+	{
+		return static_cast<size_t>(this->m_weight) + this->m_buffer.size();
+	}
+
+	double compression() const noexcept
+	{
+		return this->m_compression;
+	}
+
+	/*
+	*	value at quantile q in [0, 1]; NaN when q is out of range or nothing was added
+	*/
+	double quantile(double q) const
+	{
+		return this->quantile(std::vector<double>{ q })[0];
+	}
+
+	std::vector<double> quantile(const std::vector<double>& qs) const
+	{
+		std::vector<double> out(qs.size(), std::numeric_limits<double>::quiet_NaN());
+		if (!this->count()) { return out; }
+
+		const c_tdigest* digest = this;
+		c_tdigest flushed;
+		if (!this->m_buffer.empty())
+		{
+			flushed = *this;
+			flushed._compress();
+			digest = &flushed;
+		}
+
+		for (size_t i = 0; i < qs.size(); ++i)
+		{
+			if (qs[i] >= 0.0 && qs[i] <= 1.0) { out[i] = digest->_quantile(qs[i]); }
+		}
+
+		return out;
+	}
+};
+
+/*
+*	df.rolling(name, window, min_periods): statistics of the trailing window ending at each row, one value per row, each
+*	computed in one O(n) pass. value i equals the reduction over rows [i - window + 1, i] (sum(name, i - window + 1, window)
+*	and so on: NaN values are skipped, mean and var divide by the rows in the window) and is NaN while the window holds
+*	fewer than min_periods non-NaN values; min_periods 0 asks for window values
+*/
+class c_rolling
+{
+private:
+
+	std::vector<double> m_values;
+	size_t m_window = 0;
+	size_t m_min_periods = 0;
+
+	/*
+	*	non-NaN count, infinities, a compensated (Neumaier) sum and Welford mean/m2 of the finite values in the window
+	*/
+	struct s_window
+	{
+		size_t n = 0;
+		size_t finite = 0;
+		size_t pos_inf = 0;
+		size_t neg_inf = 0;
+		double sum = 0.0;
+		double comp = 0.0;
+		double mean = 0.0;
+		double m2 = 0.0;
+
+		void _accumulate(double x)
+		{
+			const double t = this->sum + x;
+			if (std::fabs(this->sum) >= std::fabs(x)) { this->comp += (this->sum - t) + x; }
+			else { this->comp += (x - t) + this->sum; }
+			this->sum = t;
+		}
+
+		void add(double x)
+		{
+			if (std::isnan(x)) { return; }
+
+			++this->n;
+			if (std::isinf(x)) { ++(x > 0 ? this->pos_inf : this->neg_inf); return; }
+
+			++this->finite;
+			this->_accumulate(x);
+			const double delta = x - this->mean;
+			this->mean += delta / static_cast<double>(this->finite);
+			this->m2 += delta * (x - this->mean);
+		}
+
+		void remove(double x)
+		{
+			if (std::isnan(x)) { return; }
+
+			--this->n;
+			if (std::isinf(x)) { --(x > 0 ? this->pos_inf : this->neg_inf); return; }
+
+			--this->finite;
+			this->_accumulate(-x);
+			if (!this->finite)
+			{
+				this->sum = this->comp = this->mean = this->m2 = 0.0;
+				return;
+			}
+
+			const double delta = x - this->mean;
+			this->mean -= delta / static_cast<double>(this->finite);
+			this->m2 = std::max(0.0, this->m2 - delta * (x - this->mean));
+		}
+
+		double total() const
+		{
+			if (this->pos_inf && this->neg_inf) { return std::numeric_limits<double>::quiet_NaN(); }
+			if (this->pos_inf) { return std::numeric_limits<double>::infinity(); }
+			if (this->neg_inf) { return -std::numeric_limits<double>::infinity(); }
+			return this->sum + this->comp;
+		}
+	};
+
+	size_t _min_periods() const noexcept
+	{
+		return this->m_min_periods ? this->m_min_periods : this->m_window;
+	}
+
+	/*
+	*	value(window, rows) for every row whose window holds at least min_periods values
+	*/
+	template<class fn_t>
+	std::vector<double> _slide(fn_t&& value) const
+	{
+		const size_t count = this->m_values.size();
+		const size_t min_periods = this->_min_periods();
+
+		std::vector<double> out(count, std::numeric_limits<double>::quiet_NaN());
+		s_window w;
+		for (size_t i = 0; i < count; ++i)
+		{
+			w.add(this->m_values[i]);
+			if (i >= this->m_window) { w.remove(this->m_values[i - this->m_window]); }
+
+			if (w.n && w.n >= min_periods) { out[i] = value(w, std::min(i + 1, this->m_window)); }
+		}
+		return out;
+	}
+
+	/*
+	*	monotonic deque of row indices: values only increase (min) or decrease (max) from the front, which is the answer
+	*/
+	template<class cmp_t>
+	std::vector<double> _extreme(cmp_t&& keeps) const
+	{
+		const size_t count = this->m_values.size();
+		const size_t min_periods = this->_min_periods();
+
+		std::vector<double> out(count, std::numeric_limits<double>::quiet_NaN());
+		std::deque<size_t> q;
+		size_t n = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const double x = this->m_values[i];
+			if (!std::isnan(x))
+			{
+				while (!q.empty() && !keeps(this->m_values[q.back()], x)) { q.pop_back(); }
+				q.push_back(i);
+				++n;
+			}
+
+			if (i >= this->m_window && !std::isnan(this->m_values[i - this->m_window])) { --n; }
+			while (!q.empty() && q.front() + this->m_window <= i) { q.pop_front(); }
+
+			if (n && n >= min_periods) { out[i] = this->m_values[q.front()]; }
+		}
+		return out;
+	}
+
+public:
+
+	c_rolling(std::vector<double> values, size_t window, size_t min_periods) : m_values(std::move(values)), m_window(window), m_min_periods(min_periods)
+	{
+		if (!this->m_window) { this->m_values.clear(); }
+	}
+
+	std::vector<double> sum() const
+	{
+		return this->_slide([](const s_window& w, size_t) { return w.total(); });
+	}
+
+	std::vector<double> mean() const
+	{
+		return this->_slide([](const s_window& w, size_t rows) { return w.total() / static_cast<double>(rows); });
+	}
+
+	std::vector<double> var() const
+	{
+		return this->_slide([](const s_window& w, size_t rows) {
+			if (rows < 2) { return 0.0; }
+			if (w.pos_inf || w.neg_inf) { return std::numeric_limits<double>::quiet_NaN(); }
+			return w.m2 / static_cast<double>(rows - 1);
+			});
+	}
+
+	std::vector<double> std() const
+	{
+		std::vector<double> out = this->var();
+		for (double& v : out) { v = std::sqrt(v); }
+		return out;
+	}
+
+	std::vector<double> min() const
+	{
+		return this->_extreme([](double kept, double x) { return kept < x; });
+	}
+
+	std::vector<double> max() const
+	{
+		return this->_extreme([](double kept, double x) { return kept > x; });
+	}
+};
+
+class c_dataframe;
+
+/*
+*	df.col(name) compared with a number or a string builds a c_mask over the rows of df
+*/
+struct s_column_ref
+{
+	const c_dataframe* df = nullptr;
+	std::string name;
+};
+
+class c_dataframe
+{
+private:
+
+#ifdef _USE_ORDERED_COLUMNS
+	std::map<std::string, c_column> m_data;
+#else
+	std::unordered_map<std::string, c_column> m_data;
+#endif
+	size_t m_rows = 0;
+
+	/*
+	*	lazy row deletion: m_rows counts the live rows, the first m_start physical rows are dropped and set bits of m_dead mark
+	*	dropped rows after them. the rows at m_start and at the back are always live; compact() erases the dropped rows
+	*/
+	size_t m_start = 0;
+	size_t m_dead_rows = 0;
+	std::vector<uint64_t> m_dead;
+
+	static constexpr size_t _parse_chunk = 1024;
+
+	static bool _is_blank(std::string_view sv)
+	{
+		for (unsigned char c : sv)
+		{
+			if (!std::isspace(c)) { return false; }
+		}
+		return true;
+	}
+
+	static double _to_double(std::string_view sv)
+	{
+		if (_is_blank(sv)) { return std::numeric_limits<double>::quiet_NaN(); }
+		return c_column::parse_double(sv).value_or(std::numeric_limits<double>::quiet_NaN());
+	}
+
+	template<class t>
+	static c_column _to_column(const std::vector<t>& v);
+
+	template<class t>
+	static c_column _to_column(std::vector<t>&& v);
+
+	static c_column _to_column(const std::vector<value_t>& v)
+	{
+		bool all_double = true;
+		bool all_string = true;
+		for (const auto& x : v)
+		{
+			if (std::holds_alternative<double>(x)) { all_string = false; }
+			else { all_double = false; }
+		}
+
+		if (all_double && !v.empty())
+		{
+			std::vector<double> out;
+			out.reserve(v.size());
+			for (const auto& x : v) { out.push_back(std::get<double>(x)); }
+			return c_column(std::move(out));
+		}
+
+		std::vector<std::string> out;
+		out.reserve(v.size());
+		for (const auto& x : v)
+		{
+			if (all_string) { out.push_back(std::get<std::string>(x)); }
+			else { out.push_back(std::holds_alternative<double>(x) ? c_column::format_double(std::get<double>(x)) : std::get<std::string>(x)); }
+		}
+		return c_column(std::move(out));
+	}
+
+	/*
+	*	fields without quotes, or wrapped in one pair of quotes, are returned as views into the input; anything else is unescaped into scratch
+	*/
+	static std::string_view _unquote_csv_field(const char* b, const char* e, bool quoted, std::string& scratch)
+	{
+		if (!quoted) { return std::string_view(b, static_cast<size_t>(e - b)); }
+
+		if (e - b >= 2 && b[0] == '"' && e[-1] == '"' && std::find(b + 1, e - 1, '"') == e - 1)
+		{
+			return std::string_view(b + 1, static_cast<size_t>(e - b - 2));
+		}
+
+		scratch.clear();
+
+		bool in_quotes = false;
+		for (const char* p = b; p < e; ++p)
+		{
+			char c = *p;
+			if (in_quotes)
+			{
+				if (c == '"') {
+					if (p + 1 < e && p[1] == '"') { scratch.push_back('"'); ++p; }
+					else { in_quotes = false; }
+				}
+				else scratch.push_back(c);
+			}
+			else
+			{
+				if (c == '"') { in_quotes = true; }
+				else { scratch.push_back(c); }
+			}
+		}
+
+		return scratch;
+	}
+
+	/*
+	*	walks the structural index of [begin, end): a comma or newline is a separator when an even number of quotes precedes it.
+	*	calls on_field(index, view) per field and on_record() after each record, stopping early when on_record() returns false.
+	*	returns the start of the first unconsumed record. a trailing '\r' before the newline is dropped
+	*/
+	template<class field_fn_t, class record_fn_t>
+	static const char* _tokenize_csv(const char* begin, const char* end, std::string& scratch, field_fn_t&& on_field, record_fn_t&& on_record)
+	{
+		const char* start = begin;
+		size_t index = 0;
+		bool quoted = false;
+		bool stopped = false;
+		uint64_t carry = 0;
+
+		auto finish = [&](const char* separator, bool record) {
+			const char* field_end = separator;
+			if (record && field_end > start && field_end[-1] == '\r') { --field_end; }
+			on_field(index++, _unquote_csv_field(start, field_end, quoted, scratch));
+			start = separator + 1;
+			quoted = false;
+			if (record)
+			{
+				index = 0;
+				if (!on_record()) { stopped = true; }
+			}
+			};
+
+		n_simd::scan_csv_blocks(begin, end, [&](const char* block, const n_simd::s_csv_masks& m, size_t) {
+			const uint64_t inside = n_simd::prefix_xor(m.quotes) ^ carry;
+			carry = 0 - (inside >> 63);
+
+			uint64_t separators = (m.commas | m.newlines) & ~inside;
+			while (separators)
+			{
+				const unsigned bit = n_simd::ctz(separators);
+				const uint64_t below = (uint64_t(1) << bit) - 1;
+				const uint64_t from = start <= block ? ~uint64_t(0) : (~uint64_t(0) << (start - block));
+				quoted |= (m.quotes & below & from) != 0;
+
+				finish(block + bit, ((m.newlines >> bit) & 1) != 0);
+				if (stopped) { return false; }
+
+				separators &= separators - 1;
+			}
+
+			if (start < block + 64)
+			{
+				const uint64_t from = start <= block ? ~uint64_t(0) : (~uint64_t(0) << (start - block));
+				quoted |= (m.quotes & from) != 0;
+			}
+
+			return true;
+			});
+
+		if (stopped) { return start; }
+
+		if (start < end || index > 0)
+		{
+			const char* field_end = end;
+			if (!carry && field_end > start && field_end[-1] == '\r') { --field_end; }
+			on_field(index, _unquote_csv_field(start, field_end, quoted, scratch));
+			on_record();
+		}
+
+		return end;
+	}
+
+	/*
+	*	returns the end of the n-th complete record in [begin, end), or of the last complete one when there are fewer; records
+	*	receives how many were passed
+	*/
+	static const char* _seek_csv_records(const char* begin, const char* end, size_t n, size_t& records)
+	{
+		const char* last = begin;
+		uint64_t carry = 0;
+		records = 0;
+
+		n_simd::scan_csv_blocks(begin, end, [&](const char* block, const n_simd::s_csv_masks& m, size_t) {
+			const uint64_t inside = n_simd::prefix_xor(m.quotes) ^ carry;
+			carry = 0 - (inside >> 63);
+
+			uint64_t newlines = m.newlines & ~inside;
+			if (!newlines) { return true; }
+
+			const size_t count = n_simd::popcount(newlines);
+			if (records + count < n)
+			{
+				records += count;
+				last = block + n_simd::msb(newlines) + 1;
+				return true;
+			}
+
+			for (size_t k = n - records - 1; k > 0; --k) { newlines &= newlines - 1; }
+			records = n;
+			last = block + n_simd::ctz(newlines) + 1;
+			return false;
+			});
+
+		return last;
+	}
+
+	static size_t _count_csv_records(const char* begin, const char* end)
+	{
+		size_t records = 0;
+		const char* last = _seek_csv_records(begin, end, std::numeric_limits<size_t>::max(), records);
+		return records + (last < end ? 1 : 0);
+	}
+
+	static std::optional<int64_t> _parse_int(std::string_view sv)
+	{
+		int64_t v = 0;
+		auto* b = sv.data(); auto* e = b + sv.size();
+		auto [p, ec] = std::from_chars(b, e, v);
+		if (sv.empty() || ec != std::errc() || p != e) { return std::nullopt; }
+		return v;
+	}
+
+	static std::optional<bool> _parse_bool(std::string_view sv)
+	{
+		auto eq = [&](std::string_view t) {
+			if (sv.size() != t.size()) { return false; }
+			for (size_t i = 0; i < sv.size(); ++i)
+			{
+				if ((char)std::tolower((unsigned char)sv[i]) != t[i]) { return false; }
+			}
+			return true;
+			};
+
+		if (eq("1") || eq("true")) { return true; }
+		if (eq("0") || eq("false")) { return false; }
+		return std::nullopt;
+	}
+
+	/*
+	*	tracks the narrowest of i64 -> f64 -> str that holds every non-blank field seen; blanks force f64 so they can become NaN
+	*/
+	struct s_dtype_inference
+	{
+		bool any = false;
+		bool blanks = false;
+		bool ints = true;
+		bool numeric = true;
+
+		void add(std::string_view sv)
+		{
+			if (!this->numeric) { return; }
+			if (_is_blank(sv)) { this->blanks = true; return; }
+
+			this->any = true;
+			if (this->ints && _parse_int(sv).has_value()) { return; }
+			this->ints = false;
+			if (!c_column::parse_double(sv).has_value()) { this->numeric = false; }
+		}
+
+		void merge(const s_dtype_inference& other)
+		{
+			this->any |= other.any;
+			this->blanks |= other.blanks;
+			this->ints &= other.ints;
+			this->numeric &= other.numeric;
+		}
+
+		e_dtype type() const
+		{
+			if (!this->numeric || !this->any) { return e_dtype::str; }
+			return (this->ints && !this->blanks) ? e_dtype::i64 : e_dtype::f64;
+		}
+	};
+
+	struct s_csv_chunk
+	{
+		const char* begin = nullptr;
+		const char* end = nullptr;
+		size_t rows = 0;
+		size_t offset = 0;
+		std::vector<s_dtype_inference> inference;
+		std::vector<uint8_t> failed;
+		std::vector<uint8_t> keep;
+	};
+
+	/*
+	*	usecols and predicate columns resolved to field indices
+	*/
+	struct s_csv_plan
+	{
+		std::vector<uint8_t> selected;
+		std::vector<std::vector<s_predicate>> where;
+
+		bool is_selected(size_t i) const
+		{
+			return this->selected.empty() || (i < this->selected.size() && this->selected[i]);
+		}
+	};
+
+	static constexpr size_t _csv_chunk_bytes = size_t(1) << 20;
+
+	/*
+	*	returns false when the field does not fit the column type; rows are pre-sized so chunks write disjoint slots in parallel
+	*/
+	static bool _store_field(c_column& col, size_t row, std::string_view sv)
+	{
+		switch (col.type())
+		{
+		case e_dtype::f64:
+		{
+			double d = std::numeric_limits<double>::quiet_NaN();
+			if (!_is_blank(sv))
+			{
+				auto parsed = c_column::parse_double(sv);
+				if (!parsed.has_value()) { return false; }
+				d = *parsed;
+			}
+			col.buffer<double>()[row] = d;
+			return true;
+		}
+		case e_dtype::i64:
+		{
+			auto parsed = _parse_int(sv);
+			if (!parsed.has_value()) { return false; }
+			col.buffer<int64_t>()[row] = *parsed;
+			return true;
+		}
+		case e_dtype::boolean:
+		{
+			auto parsed = _parse_bool(sv);
+			if (!parsed.has_value()) { return false; }
+			col.buffer<uint8_t>()[row] = *parsed ? 1 : 0;
+			return true;
+		}
+		case e_dtype::str:
+		{
+			col.buffer<std::string>()[row].assign(sv.data(), sv.size());
+			return true;
+		}
+		}
+
+		return false;
+	}
+
+	/*
+	*	splits [begin, end) into chunks that start on record boundaries. a newline ends a record only when an even number of quotes
+	*	precedes it, so each slice records its quote count and its first newline under both parities; a serial prefix over the
+	*	quote counts then picks the right one
+	*/
+	static std::vector<s_csv_chunk> _split_csv(const char* begin, const char* end)
+	{
+		const size_t bytes = static_cast<size_t>(end - begin);
+		const size_t parts = std::max<size_t>(1, std::min(c_thread_pool::get().size() * 4, bytes / _csv_chunk_bytes));
+
+		struct s_slice
+		{
+			size_t quotes = 0;
+			const char* newline[2] = { nullptr, nullptr };
+		};
+
+		std::vector<s_slice> slices(parts);
+		c_thread_pool::get().parallel_for(parts, [&](size_t c) {
+			const char* p = begin + bytes * c / parts;
+			const char* e = begin + bytes * (c + 1) / parts;
+
+			s_slice& slice = slices[c];
+			uint64_t carry = 0;
+			n_simd::scan_csv_blocks(p, e, [&](const char* block, const n_simd::s_csv_masks& m, size_t) {
+				const uint64_t inside = n_simd::prefix_xor(m.quotes) ^ carry;
+				carry = 0 - (inside >> 63);
+
+				const uint64_t even = m.newlines & ~inside;
+				const uint64_t odd = m.newlines & inside;
+				if (!slice.newline[0] && even) { slice.newline[0] = block + n_simd::ctz(even); }
+				if (!slice.newline[1] && odd) { slice.newline[1] = block + n_simd::ctz(odd); }
+
+				slice.quotes += n_simd::popcount(m.quotes);
+				return true;
+				});
+			});
+
+		std::vector<s_csv_chunk> chunks(1);
+		chunks.back().begin = begin;
+
+		/*
+		*	chunk c - 1 ends at the first record boundary inside slice c
+		*/
+		size_t parity = 0;
+		for (size_t c = 1; c < parts; ++c)
+		{
+			parity ^= slices[c - 1].quotes & 1;
+			const char* newline = slices[c].newline[parity];
+
+			if (!newline || newline + 1 <= chunks.back().begin) { continue; }
+
+			chunks.back().end = newline + 1;
+			chunks.emplace_back();
+			chunks.back().begin = newline + 1;
+		}
+		chunks.back().end = end;
+
+		return chunks;
+	}
+
+	/*
+	*	names are the header fields, or empty without a header in which case columns are addressed as col_<i>
+	*/
+	static bool _plan_csv(const std::vector<std::string>& names, const s_csv_options& options, s_csv_plan& plan)
+	{
+		auto index = [&](const std::string& name) -> std::optional<size_t> {
+			if (options.header)
+			{
+				auto it = std::find(names.begin(), names.end(), name);
+				if (it != names.end()) { return static_cast<size_t>(it - names.begin()); }
+				return std::nullopt;
+			}
+
+			if (name.compare(0, 4, "col_") != 0) { return std::nullopt; }
+			size_t i = 0;
+			auto [p, ec] = std::from_chars(name.data() + 4, name.data() + name.size(), i);
+			if (name.size() == 4 || ec != std::errc() || p != name.data() + name.size()) { return std::nullopt; }
+			return i;
+			};
+
+		for (const auto& name : options.usecols)
+		{
+			auto i = index(name);
+			if (!i.has_value())
+			{
+				c_logger::get().log("[c_dataframe]: No column name: " + name + "\n", LOG_CLR_RED);
+				return false;
+			}
+
+			if (*i >= plan.selected.size()) { plan.selected.resize(*i + 1, 0); }
+			plan.selected[*i] = 1;
+		}
+
+		for (const auto& predicate : options.where)
+		{
+			auto i = index(predicate.column);
+			if (!i.has_value())
+			{
+				c_logger::get().log("[c_dataframe]: No column name: " + predicate.column + "\n", LOG_CLR_RED);
+				return false;
+			}
+
+			if (*i >= plan.where.size()) { plan.where.resize(*i + 1); }
+			plan.where[*i].push_back(predicate);
+		}
+
+		return true;
+	}
+
+	/*
+	*	without a header the field count is only known after sampling, so col_<i> names past it are rejected here
+	*/
+	static bool _check_csv_plan(const std::vector<std::string>& names, const s_csv_plan& plan)
+	{
+		const size_t needed = std::max(plan.selected.size(), plan.where.size());
+		if (needed <= names.size()) { return true; }
+
+		c_logger::get().log("[c_dataframe]: No column name: col_" + std::to_string(needed - 1) + "\n", LOG_CLR_RED);
+		return false;
+	}
+
+	template<class t>
+	static bool _compare(const t& a, e_compare op, const t& b)
+	{
+		switch (op)
+		{
+		case e_compare::eq: return a == b;
+		case e_compare::ne: return a != b;
+		case e_compare::lt: return a < b;
+		case e_compare::le: return a <= b;
+		case e_compare::gt: return a > b;
+		case e_compare::ge: return a >= b;
+		}
+		return false;
+	}
+
+	static bool _test_csv_field(const s_predicate& predicate, std::string_view sv)
+	{
+		if (const double* d = std::get_if<double>(&predicate.value)) { return _compare(_to_double(sv), predicate.op, *d); }
+		return _compare(sv, predicate.op, std::string_view(std::get<std::string>(predicate.value)));
+	}
+
+	/*
+	*	evaluates the predicates on their own fields only and records which records of each chunk survive; chunk.rows becomes the
+	*	kept count so the parse pass can pre-size for survivors only
+	*/
+	static void _filter_csv_chunks(std::vector<s_csv_chunk>& chunks, const s_csv_plan& plan)
+	{
+		if (plan.where.empty()) { return; }
+
+		c_thread_pool::get().parallel_for(chunks.size(), [&](size_t c) {
+			s_csv_chunk& chunk = chunks[c];
+			std::string scratch;
+			std::vector<uint8_t> seen(plan.where.size(), 0);
+			bool keep = true;
+
+			chunk.keep.clear();
+			chunk.keep.reserve(chunk.rows);
+			chunk.rows = 0;
+
+			_tokenize_csv(chunk.begin, chunk.end, scratch,
+				[&](size_t i, std::string_view sv) {
+					if (i >= plan.where.size() || plan.where[i].empty()) { return; }
+					seen[i] = 1;
+					for (const auto& predicate : plan.where[i]) { keep = keep && _test_csv_field(predicate, sv); }
+				},
+				[&]() {
+					for (size_t i = 0; i < plan.where.size(); ++i)
+					{
+						if (!seen[i])
+						{
+							for (const auto& predicate : plan.where[i]) { keep = keep && _test_csv_field(predicate, std::string_view()); }
+						}
+						seen[i] = 0;
+					}
+
+					chunk.keep.push_back(keep ? 1 : 0);
+					chunk.rows += keep ? 1 : 0;
+					keep = true;
+					return true;
+				});
+			});
+	}
+
+	static void _infer_csv_sample(const char* begin, const char* end, const s_csv_options& options, const s_csv_plan& plan, std::vector<s_dtype_inference>& inference)
+	{
+		std::string scratch;
+		size_t sampled = 0;
+		_tokenize_csv(begin, end, scratch,
+			[&](size_t i, std::string_view sv) {
+				if (i >= inference.size())
+				{
+					if (options.header) { return; }
+					inference.resize(i + 1);
+				}
+				if (plan.is_selected(i)) { inference[i].add(sv); }
+			},
+			[&]() { return !options.infer_rows || ++sampled < options.infer_rows; });
+	}
+
+	/*
+	*	parses every chunk straight into its rows of the pre-sized typed buffers, skipping unselected fields and filtered records;
+	*	columns where a field did not fit are widened (i64 -> f64 -> str) and parsed again on their own. fails only when a forced
+	*	column does not fit
+	*/
+	static bool _parse_csv_chunks(std::vector<s_csv_chunk>& chunks, std::vector<c_column>& columns, const std::vector<std::string>& names, const std::vector<uint8_t>& forced, const s_csv_plan& plan)
+	{
+		size_t records = 0;
+		for (auto& chunk : chunks)
+		{
+			chunk.offset = records;
+			records += chunk.rows;
+		}
+
+		std::vector<uint8_t> active(columns.size(), 0);
+		for (size_t i = 0; i < columns.size(); ++i) { active[i] = plan.is_selected(i) ? 1 : 0; }
+
+		while (true)
+		{
+			c_thread_pool::get().parallel_for(chunks.size(), [&](size_t c) {
+				s_csv_chunk& chunk = chunks[c];
+				std::string scratch;
+				chunk.failed.assign(columns.size(), 0);
+
+				size_t row = chunk.offset;
+				size_t record = 0;
+				size_t fields = 0;
+				bool keep = chunk.keep.empty() || chunk.keep[0];
+				_tokenize_csv(chunk.begin, chunk.end, scratch,
+					[&](size_t i, std::string_view sv) {
+						fields = i + 1;
+						if (!keep || i >= columns.size() || !active[i] || chunk.failed[i]) { return; }
+						if (!_store_field(columns[i], row, sv)) { chunk.failed[i] = 1; }
+					},
+					[&]() {
+						if (keep)
+						{
+							for (size_t i = fields; i < columns.size(); ++i)
+							{
+								if (active[i] && !chunk.failed[i] && !_store_field(columns[i], row, std::string_view())) { chunk.failed[i] = 1; }
+							}
+							row++;
+						}
+						fields = 0;
+						record++;
+						keep = chunk.keep.empty() || (record < chunk.keep.size() && chunk.keep[record]);
+						return true;
+					});
+				});
+
+			bool retry = false;
+			for (size_t i = 0; i < columns.size(); ++i)
+			{
+				bool failed = false;
+				for (const auto& chunk : chunks) { failed |= chunk.failed[i] != 0; }
+
+				active[i] = failed;
+				if (!failed) { continue; }
+
+				if (forced[i])
+				{
+					c_logger::get().log("[c_dataframe]: Schema mismatch: " + names[i] + "\n", LOG_CLR_RED);
+					return false;
+				}
+
+				columns[i] = c_column(columns[i].type() == e_dtype::i64 ? e_dtype::f64 : e_dtype::str, records);
+				retry = true;
+			}
+
+			if (!retry)
+			{
+				for (size_t i = 0; i < columns.size(); ++i) { columns[i].touch(); }
+				return true;
+			}
+		}
+	}
+
+	static constexpr size_t _csv_write_rows = size_t(1) << 14;
+
+	/*
+	*	quotes only fields holding a comma, quote or line break, doubling embedded quotes
+	*/
+	static void _write_csv_string(const std::string& value, std::string& out)
+	{
+		if (value.find_first_of(",\"\r\n") == std::string::npos)
+		{
+			out.append(value);
+			return;
+		}
+
+		out.push_back('"');
+		for (char c : value)
+		{
+			if (c == '"') { out.push_back('"'); }
+			out.push_back(c);
+		}
+		out.push_back('"');
+	}
+
+	/*
+	*	doubles are written in their shortest round-trip form, so from_csv reads back the exact value
+	*/
+	static void _write_csv_field(const c_column& col, size_t row, std::string& out)
+	{
+		char buf[32];
+		switch (col.type())
+		{
+		case e_dtype::f64:
+		{
+			auto [p, ec] = std::to_chars(buf, buf + sizeof(buf), col.data<double>()[row]);
+			out.append(buf, p);
+			return;
+		}
+		case e_dtype::i64:
+		{
+			auto [p, ec] = std::to_chars(buf, buf + sizeof(buf), col.data<int64_t>()[row]);
+			out.append(buf, p);
+			return;
+		}
+		case e_dtype::boolean: out.push_back(col.data<uint8_t>()[row] ? '1' : '0'); return;
+		case e_dtype::str: _write_csv_string(col.values<std::string>()[row], out); return;
+		}
+	}
+
+	/*
+	*	binary columnar file, native little-endian:
+	*		header		"DFC1", u32 1 (byte order check), u64 rows, u64 columns
+	*		directory	per column: u8 dtype, u32 name bytes, name, u64 data offset, u64 data bytes
+	*		data		per column at a 64-byte aligned offset: rows f64 / i64 values, rows bytes for bool, or for strings
+	*					(rows + 1) u64 offsets followed by the concatenated bytes they index
+	*/
+	static constexpr char _binary_magic[4] = { 'D', 'F', 'C', '1' };
+	static constexpr uint64_t _binary_align = 64;
+
+	template<class t>
+	static void _write_pod(std::ofstream& file, const t& v)
+	{
+		file.write(reinterpret_cast<const char*>(&v), sizeof(t));
+	}
+
+	template<class t>
+	static bool _read_pod(const char* data, size_t size, size_t& pos, t& v)
+	{
+		if (size - pos < sizeof(t)) { return false; }
+		std::memcpy(&v, data + pos, sizeof(t));
+		pos += sizeof(t);
+		return true;
+	}
+
+	static uint64_t _binary_bytes(const c_column& col)
+	{
+		return col.visit([](const auto& v) -> uint64_t {
+			using t = typename std::decay_t<decltype(v)>::value_type;
+			if constexpr (std::is_same_v<t, std::string>)
+			{
+				uint64_t bytes = (v.size() + 1) * sizeof(uint64_t);
+				for (const auto& x : v) { bytes += x.size(); }
+				return bytes;
+			}
+			else { return v.size() * sizeof(t); }
+			});
+	}
+
+	/*
+	*	numeric columns become views into the mapping when mapped is set and the buffer is aligned, otherwise they are copied
+	*/
+	static bool _read_binary_column(const std::shared_ptr<c_mapped_file>& file, e_dtype type, uint64_t rows, uint64_t offset, uint64_t bytes, bool mapped, c_column& out)
+	{
+		const char* p = file->data() + offset;
+
+		auto numeric = [&](auto tag) {
+			using t = decltype(tag);
+			if (rows > bytes / sizeof(t) || rows * sizeof(t) != bytes) { return false; }
+
+			if (mapped && reinterpret_cast<uintptr_t>(p) % alignof(t) == 0)
+			{
+				out = c_column::view(type, p, static_cast<size_t>(rows), file);
+				return true;
+			}
+
+			std::vector<t> v(static_cast<size_t>(rows));
+			std::memcpy(v.data(), p, static_cast<size_t>(bytes));
+			out = c_column(std::move(v));
+			return true;
+			};
+
+		switch (type)
+		{
+		case e_dtype::f64: return numeric(double());
+		case e_dtype::i64: return numeric(int64_t());
+		case e_dtype::boolean: return numeric(uint8_t());
+		case e_dtype::str: break;
+		}
+
+		if (rows >= bytes / sizeof(uint64_t)) { return false; }
+
+		const uint64_t index = (rows + 1) * sizeof(uint64_t);
+		const char* chars = p + index;
+
+		std::vector<std::string> v(static_cast<size_t>(rows));
+		uint64_t from = 0;
+		std::memcpy(&from, p, sizeof(uint64_t));
+		for (size_t i = 0; i < v.size(); ++i)
+		{
+			uint64_t to = 0;
+			std::memcpy(&to, p + (i + 1) * sizeof(uint64_t), sizeof(uint64_t));
+			if (to < from || to > bytes - index) { return false; }
+
+			v[i].assign(chars + from, static_cast<size_t>(to - from));
+			from = to;
+		}
+
+		out = c_column(std::move(v));
+		return true;
+	}
+
+	/*
+	*	arrow ipc (feather v2). type ids are those of the Type union in Schema.fbs
+	*/
+	enum e_arrow_type : uint8_t
+	{
+		arrow_int = 2,
+		arrow_float = 3,
+		arrow_binary = 4,
+		arrow_utf8 = 5,
+		arrow_bool = 6,
+		arrow_large_binary = 19,
+		arrow_large_utf8 = 20
+	};
+
+	struct s_arrow_field
+	{
+		std::string name;
+		uint8_t type = 0;
+		int32_t bits = 0;
+		bool is_signed = false;
+		int16_t precision = 0;
+	};
+
+	struct s_arrow_batch
+	{
+		const uint8_t* body = nullptr;
+		size_t body_size = 0;
+		int64_t rows = 0;
+		n_flatbuffers::s_vector nodes;
+		n_flatbuffers::s_vector buffers;
+		bool compressed = false;
+	};
+
+	static size_t _arrow_buffer_count(uint8_t type)
+	{
+		return (type == arrow_int || type == arrow_float || type == arrow_bool) ? 2 : 3;
+	}
+
+	static bool _arrow_node(const s_arrow_batch& batch, size_t index, int64_t& length, int64_t& nulls)
+	{
+		const uint8_t* p = batch.nodes.element(index, 16);
+		if (!p) { return false; }
+
+		std::memcpy(&length, p, sizeof(int64_t));
+		std::memcpy(&nulls, p + 8, sizeof(int64_t));
+		return length == batch.rows && nulls >= 0 && nulls <= length;
+	}
+
+	/*
+	*	resolves buffer index of a batch body; compressed buffers carry their uncompressed length (-1 when stored raw) and are
+	*	decoded into storage
+	*/
+	static bool _arrow_buffer(const s_arrow_batch& batch, size_t index, std::vector<uint8_t>& storage, const uint8_t*& data, size_t& size)
+	{
+		const uint8_t* p = batch.buffers.element(index, 16);
+		if (!p) { return false; }
+
+		int64_t offset = 0, length = 0;
+		std::memcpy(&offset, p, sizeof(int64_t));
+		std::memcpy(&length, p + 8, sizeof(int64_t));
+		if (offset < 0 || length < 0 || static_cast<uint64_t>(offset) > batch.body_size || static_cast<uint64_t>(length) > batch.body_size - offset) { return false; }
+
+		data = batch.body + offset;
+		size = static_cast<size_t>(length);
+		if (!batch.compressed || !size) { return true; }
+
+		int64_t raw = 0;
+		if (size < sizeof(int64_t)) { return false; }
+		std::memcpy(&raw, data, sizeof(int64_t));
+		data += sizeof(int64_t);
+		size -= sizeof(int64_t);
+
+		if (raw == -1) { return true; }
+		if (raw < 0 || static_cast<uint64_t>(raw) / 256 > size) { return false; }
+
+		storage.resize(static_cast<size_t>(raw));
+		if (!n_lz4::decode_frame(data, size, storage.data(), storage.size())) { return false; }
+
+		data = storage.data();
+		size = storage.size();
+		return true;
+	}
+
+	template<class src_t, class dst_t>
+	static void _arrow_copy(const uint8_t* values, const uint8_t* validity, size_t n, dst_t* out)
+	{
+		if (std::is_same_v<src_t, dst_t> && !validity)
+		{
+			std::memcpy(out, values, n * sizeof(dst_t));
+			return;
+		}
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			src_t v;
+			std::memcpy(&v, values + i * sizeof(src_t), sizeof(src_t));
+			out[i] = static_cast<dst_t>(v);
+
+			if constexpr (std::is_floating_point_v<dst_t>)
+			{
+				if (validity && !((validity[i >> 3] >> (i & 7)) & 1)) { out[i] = std::numeric_limits<dst_t>::quiet_NaN(); }
+			}
+		}
+	}
+
+	/*
+	*	copies one field of a batch into rows [at, at + batch.rows) of col
+	*/
+	static bool _arrow_fill(const s_arrow_batch& batch, const s_arrow_field& field, size_t node, size_t buffer, c_column& col, size_t at)
+	{
+		int64_t length = 0, nulls = 0;
+		if (!_arrow_node(batch, node, length, nulls)) { return false; }
+
+		const size_t n = static_cast<size_t>(length);
+		std::vector<uint8_t> storage[3];
+		const uint8_t* data[3] = {};
+		size_t size[3] = {};
+		for (size_t b = 0; b < _arrow_buffer_count(field.type); ++b)
+		{
+			if (!_arrow_buffer(batch, buffer + b, storage[b], data[b], size[b])) { return false; }
+		}
+
+		const uint8_t* validity = nulls ? data[0] : nullptr;
+		if (validity && size[0] < (n + 7) / 8) { return false; }
+
+		if (field.type == arrow_bool)
+		{
+			if (size[1] < (n + 7) / 8) { return false; }
+
+			if (col.type() == e_dtype::boolean)
+			{
+				uint8_t* out = col.values<uint8_t>().data() + at;
+				for (size_t i = 0; i < n; ++i) { out[i] = (data[1][i >> 3] >> (i & 7)) & 1; }
+				return true;
+			}
+
+			double* out = col.values<double>().data() + at;
+			for (size_t i = 0; i < n; ++i)
+			{
+				const bool valid = !validity || ((validity[i >> 3] >> (i & 7)) & 1);
+				out[i] = valid ? static_cast<double>((data[1][i >> 3] >> (i & 7)) & 1) : std::numeric_limits<double>::quiet_NaN();
+			}
+			return true;
+		}
+
+		if (field.type == arrow_int || field.type == arrow_float)
+		{
+			const size_t width = field.type == arrow_float ? (field.precision == 2 ? 8 : 4) : static_cast<size_t>(field.bits / 8);
+			if (size[1] / width < n) { return false; }
+
+			auto copy = [&](auto* out) {
+				if (field.type == arrow_float)
+				{
+					if (width == 8) { _arrow_copy<double>(data[1], validity, n, out); }
+					else { _arrow_copy<float>(data[1], validity, n, out); }
+					return;
+				}
+
+				switch (width)
+				{
+				case 1: field.is_signed ? _arrow_copy<int8_t>(data[1], validity, n, out) : _arrow_copy<uint8_t>(data[1], validity, n, out); break;
+				case 2: field.is_signed ? _arrow_copy<int16_t>(data[1], validity, n, out) : _arrow_copy<uint16_t>(data[1], validity, n, out); break;
+				case 4: field.is_signed ? _arrow_copy<int32_t>(data[1], validity, n, out) : _arrow_copy<uint32_t>(data[1], validity, n, out); break;
+				default: field.is_signed ? _arrow_copy<int64_t>(data[1], validity, n, out) : _arrow_copy<uint64_t>(data[1], validity, n, out); break;
+				}
+				};
+
+			if (col.type() == e_dtype::i64) { copy(col.values<int64_t>().data() + at); }
+			else { copy(col.values<double>().data() + at); }
+			return true;
+		}
+
+		const bool large = field.type == arrow_large_utf8 || field.type == arrow_large_binary;
+		const size_t width = large ? 8 : 4;
+		if (size[1] / width < n + 1) { return false; }
+
+		auto offset = [&](size_t i) -> int64_t {
+			if (large)
+			{
+				int64_t v;
+				std::memcpy(&v, data[1] + i * 8, sizeof(v));
+				return v;
+			}
+			int32_t v;
+			std::memcpy(&v, data[1] + i * 4, sizeof(v));
+			return v;
+			};
+
+		auto& strs = col.values<std::string>();
+		int64_t from = offset(0);
+		for (size_t i = 0; i < n; ++i)
+		{
+			const int64_t to = offset(i + 1);
+			if (from < 0 || to < from || static_cast<uint64_t>(to) > size[2]) { return false; }
+			strs[at + i].assign(reinterpret_cast<const char*>(data[2]) + from, static_cast<size_t>(to - from));
+			from = to;
+		}
+
+		return true;
+	}
+
+	/*
+	*	writes the Schema table with its fields into b and returns its position
+	*/
+	static size_t _arrow_schema(n_flatbuffers::c_builder& b, const std::vector<std::string>& names, const std::vector<uint8_t>& types)
+	{
+		b.add_offset(1);
+		const size_t schema = b.end_table();
+		const size_t fields_slot = b.slot(1);
+
+		const size_t list = b.add_offsets(names.size());
+		b.patch(fields_slot, list);
+
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			b.add_offset(0);
+			b.add<uint8_t>(1, 1);
+			b.add<uint8_t>(2, types[i]);
+			b.add_offset(3);
+			b.add_offset(5);
+			const size_t field = b.end_table();
+			const size_t name_slot = b.slot(0), type_slot = b.slot(3), children_slot = b.slot(5);
+
+			b.patch(list + 4 + 4 * i, field);
+			b.patch(name_slot, b.add_string(names[i]));
+
+			if (types[i] == arrow_int)
+			{
+				b.add<int32_t>(0, 64);
+				b.add<uint8_t>(1, 1);
+			}
+			else if (types[i] == arrow_float) { b.add<int16_t>(0, 2); }
+			b.patch(type_slot, b.end_table());
+
+			b.patch(children_slot, b.add_offsets(0));
+		}
+
+		return schema;
+	}
+
+	/*
+	*	continuation marker, metadata length padded so the body starts 8-byte aligned, then the flatbuffer; returns the bytes written
+	*/
+	static size_t _write_arrow_message(std::ofstream& file, const std::vector<uint8_t>& metadata)
+	{
+		_write_pod(file, uint32_t(0xFFFFFFFF));
+		_write_pod(file, static_cast<int32_t>(metadata.size()));
+		file.write(reinterpret_cast<const char*>(metadata.data()), static_cast<std::streamsize>(metadata.size()));
+		return 8 + metadata.size();
+	}
+
+	/*
+	*	parquet physical types, and the parts of the footer the reader uses for flat schemas
+	*/
+	enum e_parquet_type : int32_t
+	{
+		parquet_boolean = 0,
+		parquet_int32 = 1,
+		parquet_int64 = 2,
+		parquet_float = 4,
+		parquet_double = 5,
+		parquet_byte_array = 6
+	};
+
+	struct s_parquet_column
+	{
+		std::string name;
+		int32_t type = -1;
+		bool optional = false;
+	};
+
+	struct s_parquet_chunk
+	{
+		int32_t codec = 0;
+		int64_t values = 0;
+		int64_t offset = -1;
+		int64_t size = 0;
+		int64_t nulls = -1;
+		bool stats = false;
+		bool legacy = false;		// min / max from the deprecated Statistics fields 1 and 2, only trusted for numeric and boolean types
+		std::string min;
+		std::string max;
+	};
+
+	struct s_parquet_group
+	{
+		int64_t rows = 0;
+		size_t offset = 0;
+		std::vector<s_parquet_chunk> chunks;
+	};
+
+	/*
+	*	FileMetaData: 2 schema, 3 num_rows, 4 row_groups -> RowGroup: 1 columns, 3 num_rows -> ColumnChunk: 3 meta_data ->
+	*	ColumnMetaData: 4 codec, 5 num_values, 7 total_compressed_size, 9 data_page_offset, 11 dictionary_page_offset, 12 statistics
+	*/
+	static bool _read_parquet_footer(const uint8_t* data, size_t size, std::vector<s_parquet_column>& columns, std::vector<s_parquet_group>& groups)
+	{
+		n_thrift::s_reader r{ data, size };
+		bool flat = true;
+		int64_t children = -1;
+
+		auto statistics = [&](s_parquet_chunk& chunk) {
+			std::string legacy_min, legacy_max;
+			r.structure([&](int16_t id, uint8_t type) {
+				if (id == 1 && type == n_thrift::binary) { legacy_max = std::string(r.string()); }
+				else if (id == 2 && type == n_thrift::binary) { legacy_min = std::string(r.string()); }
+				else if (id == 3 && type == n_thrift::i64) { chunk.nulls = r.integer(type); }
+				else if (id == 5 && type == n_thrift::binary) { chunk.max = std::string(r.string()); chunk.stats = true; }
+				else if (id == 6 && type == n_thrift::binary) { chunk.min = std::string(r.string()); }
+				else { r.skip(type); }
+				});
+
+			if (!chunk.stats && !legacy_min.empty() && !legacy_max.empty())
+			{
+				chunk.min = std::move(legacy_min);
+				chunk.max = std::move(legacy_max);
+				chunk.stats = true;
+				chunk.legacy = true;
+			}
+			};
+
+		auto meta_data = [&](s_parquet_chunk& chunk) {
+			int64_t data_page = -1, dictionary_page = -1;
+			r.structure([&](int16_t id, uint8_t type) {
+				if (id == 4 && type == n_thrift::i32) { chunk.codec = static_cast<int32_t>(r.integer(type)); }
+				else if (id == 5 && type == n_thrift::i64) { chunk.values = r.integer(type); }
+				else if (id == 7 && type == n_thrift::i64) { chunk.size = r.integer(type); }
+				else if (id == 9 && type == n_thrift::i64) { data_page = r.integer(type); }
+				else if (id == 11 && type == n_thrift::i64) { dictionary_page = r.integer(type); }
+				else if (id == 12 && type == n_thrift::structure) { statistics(chunk); }
+				else { r.skip(type); }
+				});
+
+			chunk.offset = (dictionary_page > 0 && dictionary_page < data_page) ? dictionary_page : data_page;
+			};
+
+		r.structure([&](int16_t id, uint8_t type) {
+			if (id == 2 && type == n_thrift::list)
+			{
+				size_t index = 0;
+				r.list([&](uint8_t) {
+					s_parquet_column column;
+					int64_t nested = 0;
+					int64_t repetition = 0;
+					r.structure([&](int16_t field, uint8_t t) {
+						if (field == 1 && t == n_thrift::i32) { column.type = static_cast<int32_t>(r.integer(t)); }
+						else if (field == 3 && t == n_thrift::i32) { repetition = r.integer(t); }
+						else if (field == 4 && t == n_thrift::binary) { column.name = std::string(r.string()); }
+						else if (field == 5 && t == n_thrift::i32) { nested = r.integer(t); }
+						else { r.skip(t); }
+						});
+
+					if (index++ == 0) { children = nested; return; }
+
+					column.optional = repetition == 1;
+					flat &= nested == 0 && repetition != 2;
+					columns.push_back(std::move(column));
+					});
+			}
+			else if (id == 4 && type == n_thrift::list)
+			{
+				r.list([&](uint8_t) {
+					s_parquet_group group;
+					r.structure([&](int16_t field, uint8_t t) {
+						if (field == 1 && t == n_thrift::list)
+						{
+							r.list([&](uint8_t) {
+								s_parquet_chunk chunk;
+								r.structure([&](int16_t f, uint8_t tt) {
+									if (f == 3 && tt == n_thrift::structure) { meta_data(chunk); }
+									else { r.skip(tt); }
+									});
+								group.chunks.push_back(std::move(chunk));
+								});
+						}
+						else if (field == 3 && t == n_thrift::i64) { group.rows = r.integer(t); }
+						else { r.skip(t); }
+						});
+					groups.push_back(std::move(group));
+					});
+			}
+			else { r.skip(type); }
+			});
+
+		if (!r.ok) { return false; }
+		if (!flat || children != static_cast<int64_t>(columns.size()))
+		{
+			c_logger::get().log("[c_dataframe]: Unsupported parquet nested schema\n", LOG_CLR_RED);
+			return false;
+		}
+
+		for (auto& group : groups)
+		{
+			if (group.rows < 0 || group.chunks.size() != columns.size()) { return false; }
+
+			/*
+			*	old writers ordered the legacy byte array min / max as signed bytes, which can exclude valid UTF-8 values
+			*/
+			for (size_t c = 0; c < columns.size(); ++c)
+			{
+				s_parquet_chunk& chunk = group.chunks[c];
+				if (chunk.legacy && columns[c].type == parquet_byte_array)
+				{
+					chunk.stats = false;
+					chunk.min.clear();
+					chunk.max.clear();
+				}
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	*	run-length / bit-packed hybrid decoding of n values of the given bit width
+	*/
+	static bool _decode_rle(const uint8_t* p, const uint8_t* end, uint32_t width, size_t n, std::vector<uint32_t>& out)
+	{
+		out.clear();
+		if (width > 32) { return false; }
+
+		const size_t bytes = (width + 7) / 8;
+		n_thrift::s_reader r{ p, static_cast<size_t>(end - p) };
+
+		while (out.size() < n)
+		{
+			const uint64_t header = r.varint();
+			if (!r.ok) { return false; }
+
+			if (header & 1)
+			{
+				const uint64_t groups = header >> 1;
+				if (!groups || (width && groups > (r.size - r.pos) / width)) { return false; }
+
+				const uint64_t count = groups * 8;
+				const size_t length = static_cast<size_t>(groups * width);
+
+				const uint8_t* bits = r.data + r.pos;
+				for (uint64_t i = 0; i < count && out.size() < n; ++i)
+				{
+					uint64_t v = 0;
+					const uint64_t bit = i * width;
+					for (uint32_t b = 0; b < width; ++b)
+					{
+						const uint64_t at = bit + b;
+						v |= uint64_t((bits[at >> 3] >> (at & 7)) & 1) << b;
+					}
+					out.push_back(static_cast<uint32_t>(v));
+				}
+				r.pos += length;
+			}
+			else
+			{
+				const uint64_t count = std::min<uint64_t>(header >> 1, n - out.size());
+				if (bytes > r.size - r.pos) { return false; }
+
+				uint32_t v = 0;
+				for (size_t b = 0; b < bytes; ++b) { v |= uint32_t(r.data[r.pos + b]) << (8 * b); }
+				r.pos += bytes;
+				out.insert(out.end(), static_cast<size_t>(count), v);
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	*	parquet page values before nulls are scattered: bool and int columns decode into ints, float and double into reals,
+	*	byte arrays into views of the page or dictionary storage
+	*/
+	struct s_parquet_values
+	{
+		std::vector<int64_t> ints;
+		std::vector<double> reals;
+		std::vector<std::string_view> strs;
+
+		size_t size() const noexcept
+		{
+			return std::max(this->ints.size(), std::max(this->reals.size(), this->strs.size()));
+		}
+
+		void clear()
+		{
+			this->ints.clear();
+			this->reals.clear();
+			this->strs.clear();
+		}
+	};
+
+	static bool _decode_parquet_plain(int32_t type, const uint8_t* p, const uint8_t* end, size_t n, s_parquet_values& out)
+	{
+		const size_t bytes = static_cast<size_t>(end - p);
+
+		auto fixed = [&](auto tag, auto& target) {
+			using t = decltype(tag);
+			if (bytes / sizeof(t) < n) { return false; }
+			for (size_t i = 0; i < n; ++i)
+			{
+				t v;
+				std::memcpy(&v, p + i * sizeof(t), sizeof(t));
+				target.push_back(static_cast<typename std::decay_t<decltype(target)>::value_type>(v));
+			}
+			return true;
+			};
+
+		switch (type)
+		{
+		case parquet_boolean:
+			if (bytes < (n + 7) / 8) { return false; }
+			for (size_t i = 0; i < n; ++i) { out.ints.push_back((p[i >> 3] >> (i & 7)) & 1); }
+			return true;
+		case parquet_int32: return fixed(int32_t(), out.ints);
+		case parquet_int64: return fixed(int64_t(), out.ints);
+		case parquet_float: return fixed(float(), out.reals);
+		case parquet_double: return fixed(double(), out.reals);
+		case parquet_byte_array:
+			for (size_t i = 0; i < n; ++i)
+			{
+				uint32_t length = 0;
+				if (end - p < 4) { return false; }
+				std::memcpy(&length, p, sizeof(length));
+				p += 4;
+				if (length > static_cast<size_t>(end - p)) { return false; }
+				out.strs.emplace_back(reinterpret_cast<const char*>(p), length);
+				p += length;
+			}
+			return true;
+		}
+
+		return false;
+	}
+
+	/*
+	*	makes [p, p + n) the uncompressed bytes of a page, decoding into storage when the codec needs it
+	*/
+	static bool _parquet_inflate(int32_t codec, const uint8_t*& p, size_t& n, size_t raw, std::vector<uint8_t>& storage)
+	{
+		if (codec == 0) { return n == raw; }
+		if (codec != 1 && codec != 7) { return false; }
+		if (raw / 256 > n + 64) { return false; }
+
+		storage.resize(raw);
+		if (codec == 1)
+		{
+			if (!n_snappy::decode(p, n, storage.data(), raw)) { return false; }
+		}
+		else
+		{
+			size_t out = 0;
+			if (!n_lz4::decode_block(p, n, storage.data(), out, raw) || out != raw) { return false; }
+		}
+
+		p = storage.data();
+		n = raw;
+		return true;
+	}
+
+	/*
+	*	PageHeader: 1 type, 2 uncompressed_page_size, 3 compressed_page_size, 5 data_page_header, 7 dictionary_page_header,
+	*	8 data_page_header_v2. decodes every page of a chunk into rows [at, at + rows) of col
+	*/
+	static bool _read_parquet_chunk(const uint8_t* data, size_t size, const s_parquet_column& column, const s_parquet_chunk& chunk, size_t rows, c_column& col, size_t at)
+	{
+		if (chunk.offset < 0 || chunk.size < 0 || static_cast<uint64_t>(chunk.offset) > size || static_cast<uint64_t>(chunk.size) > size - chunk.offset) { return false; }
+		if (chunk.values != static_cast<int64_t>(rows)) { return false; }
+
+		const uint8_t* p = data + chunk.offset;
+		const uint8_t* end = p + chunk.size;
+
+		std::vector<uint8_t> dictionary_storage, page_storage;
+		s_parquet_values dictionary, values;
+		std::vector<uint32_t> levels, indices;
+
+		size_t row = 0;
+		while (row < rows)
+		{
+			n_thrift::s_reader r{ p, static_cast<size_t>(end - p) };
+			int64_t kind = -1, raw = 0, compressed = 0;
+			int64_t count = 0, encoding = 0, nulls = -1, level_bytes = 0, repetition_bytes = 0;
+			bool is_compressed = true;
+
+			r.structure([&](int16_t id, uint8_t type) {
+				if (id == 1 && type == n_thrift::i32) { kind = r.integer(type); }
+				else if (id == 2 && type == n_thrift::i32) { raw = r.integer(type); }
+				else if (id == 3 && type == n_thrift::i32) { compressed = r.integer(type); }
+				else if ((id == 5 || id == 7) && type == n_thrift::structure)
+				{
+					r.structure([&](int16_t f, uint8_t t) {
+						if (f == 1 && t == n_thrift::i32) { count = r.integer(t); }
+						else if (f == 2 && t == n_thrift::i32) { encoding = r.integer(t); }
+						else { r.skip(t); }
+						});
+				}
+				else if (id == 8 && type == n_thrift::structure)
+				{
+					r.structure([&](int16_t f, uint8_t t) {
+						if (f == 1 && t == n_thrift::i32) { count = r.integer(t); }
+						else if (f == 2 && t == n_thrift::i32) { nulls = r.integer(t); }
+						else if (f == 4 && t == n_thrift::i32) { encoding = r.integer(t); }
+						else if (f == 5 && t == n_thrift::i32) { level_bytes = r.integer(t); }
+						else if (f == 6 && t == n_thrift::i32) { repetition_bytes = r.integer(t); }
+						else if (f == 7) { is_compressed = t == n_thrift::bool_true; }
+						else { r.skip(t); }
+						});
+				}
+				else { r.skip(type); }
+				});
+
+			if (!r.ok || raw < 0 || compressed < 0 || compressed > static_cast<int64_t>(r.size - r.pos)) { return false; }
+
+			const uint8_t* body = p + r.pos;
+			size_t body_size = static_cast<size_t>(compressed);
+			p = body + body_size;
+
+			if (kind == 2)
+			{
+				if (count < 0 || (encoding != 0 && encoding != 2)) { return false; }
+				if (!_parquet_inflate(chunk.codec, body, body_size, static_cast<size_t>(raw), dictionary_storage)) { return false; }
+
+				dictionary.clear();
+				if (!_decode_parquet_plain(column.type, body, body + body_size, static_cast<size_t>(count), dictionary)) { return false; }
+				continue;
+			}
+
+			if (kind != 0 && kind != 3) { continue; }
+			if (count < 0 || static_cast<size_t>(count) > rows - row) { return false; }
+
+			const size_t n = static_cast<size_t>(count);
+			const uint8_t* level_begin = nullptr;
+			const uint8_t* level_end = nullptr;
+
+			if (kind == 0)
+			{
+				if (!_parquet_inflate(chunk.codec, body, body_size, static_cast<size_t>(raw), page_storage)) { return false; }
+
+				if (column.optional)
+				{
+					uint32_t length = 0;
+					if (body_size < 4) { return false; }
+					std::memcpy(&length, body, sizeof(length));
+					if (length > body_size - 4) { return false; }
+
+					level_begin = body + 4;
+					level_end = level_begin + length;
+					body += 4 + length;
+					body_size -= 4 + length;
+				}
+			}
+			else
+			{
+				if (repetition_bytes != 0 || level_bytes < 0 || static_cast<size_t>(level_bytes) > body_size || level_bytes > raw) { return false; }
+
+				level_begin = body;
+				level_end = body + level_bytes;
+				body += level_bytes;
+				body_size -= static_cast<size_t>(level_bytes);
+
+				if (is_compressed && !_parquet_inflate(chunk.codec, body, body_size, static_cast<size_t>(raw - level_bytes), page_storage)) { return false; }
+			}
+
+			size_t present = n;
+			if (column.optional && level_begin)
+			{
+				if (!_decode_rle(level_begin, level_end, 1, n, levels)) { return false; }
+				present = 0;
+				for (uint32_t level : levels) { present += level; }
+			}
+			else { levels.clear(); }
+
+			if (nulls >= 0 && !column.optional && nulls != 0) { return false; }
+
+			values.clear();
+			const uint8_t* value_end = body + body_size;
+			if (encoding == 0)
+			{
+				if (!_decode_parquet_plain(column.type, body, value_end, present, values)) { return false; }
+			}
+			else if (encoding == 2 || encoding == 8)
+			{
+				if (!body_size) { return false; }
+				if (!_decode_rle(body + 1, value_end, body[0], present, indices)) { return false; }
+
+				for (uint32_t index : indices)
+				{
+					if (index >= dictionary.size()) { return false; }
+					if (!dictionary.ints.empty()) { values.ints.push_back(dictionary.ints[index]); }
+					else if (!dictionary.reals.empty()) { values.reals.push_back(dictionary.reals[index]); }
+					else { values.strs.push_back(dictionary.strs[index]); }
+				}
+			}
+			else if (encoding == 3 && column.type == parquet_boolean)
+			{
+				if (body_size < 4) { return false; }
+				if (!_decode_rle(body + 4, value_end, 1, present, indices)) { return false; }
+				for (uint32_t v : indices) { values.ints.push_back(v); }
+			}
+			else
+			{
+				c_logger::get().log("[c_dataframe]: Unsupported parquet encoding: " + column.name + "\n", LOG_CLR_RED);
+				return false;
+			}
+
+			if (values.size() != present) { return false; }
+
+			/*
+			*	scatter the present values over the rows of the page, nulls become NaN or empty strings
+			*/
+			const size_t base = at + row;
+			size_t next = 0;
+			auto valid = [&](size_t i) { return levels.empty() || levels[i] != 0; };
+
+			switch (col.type())
+			{
+			case e_dtype::i64:
+			{
+				int64_t* out = col.buffer<int64_t>().data() + base;
+				for (size_t i = 0; i < n; ++i)
+				{
+					if (!valid(i)) { return false; }
+					out[i] = values.ints[next++];
+				}
+				break;
+			}
+			case e_dtype::boolean:
+			{
+				uint8_t* out = col.buffer<uint8_t>().data() + base;
+				for (size_t i = 0; i < n; ++i)
+				{
+					if (!valid(i)) { return false; }
+					out[i] = values.ints[next++] != 0;
+				}
+				break;
+			}
+			case e_dtype::f64:
+			{
+				double* out = col.buffer<double>().data() + base;
+				const bool ints = !values.ints.empty();
+				for (size_t i = 0; i < n; ++i)
+				{
+					if (!valid(i)) { out[i] = std::numeric_limits<double>::quiet_NaN(); continue; }
+					out[i] = ints ? static_cast<double>(values.ints[next]) : values.reals[next];
+					next++;
+				}
+				break;
+			}
+			case e_dtype::str:
+			{
+				std::string* out = col.buffer<std::string>().data() + base;
+				for (size_t i = 0; i < n; ++i)
+				{
+					if (valid(i)) { out[i].assign(values.strs[next].data(), values.strs[next].size()); next++; }
+					else { out[i].clear(); }
+				}
+				break;
+			}
+			}
+
+			row += n;
+		}
+
+		return true;
+	}
+
+	/*
+	*	plain-encoded statistic as a double; false when absent or not numeric
+	*/
+	static bool _parquet_stat(int32_t type, const std::string& raw, double& v)
+	{
+		auto get = [&](auto tag) {
+			using t = decltype(tag);
+			if (raw.size() != sizeof(t)) { return false; }
+			t x;
+			std::memcpy(&x, raw.data(), sizeof(t));
+			v = static_cast<double>(x);
+			return !std::isnan(v);
+			};
+
+		switch (type)
+		{
+		case parquet_boolean: return get(uint8_t());
+		case parquet_int32: return get(int32_t());
+		case parquet_int64: return get(int64_t());
+		case parquet_float: return get(float());
+		case parquet_double: return get(double());
+		}
+		return false;
+	}
+
+	template<class t>
+	static bool _range_may_match(const t& lo, const t& hi, e_compare op, const t& v)
+	{
+		switch (op)
+		{
+		case e_compare::eq: return !(v < lo) && !(hi < v);
+		case e_compare::lt: return lo < v;
+		case e_compare::le: return !(v < lo);
+		case e_compare::gt: return v < hi;
+		case e_compare::ge: return !(hi < v);
+		default: return true;
+		}
+	}
+
+	/*
+	*	false only when the chunk statistics prove no row can satisfy the predicate. null strings load as "", so a chunk with
+	*	nulls also covers ""
+	*/
+	static bool _parquet_may_match(const s_parquet_column& column, const s_parquet_chunk& chunk, const s_predicate& predicate)
+	{
+		if (!chunk.stats) { return true; }
+
+		if (const double* d = std::get_if<double>(&predicate.value))
+		{
+			double lo = 0.0, hi = 0.0;
+			if (!_parquet_stat(column.type, chunk.min, lo) || !_parquet_stat(column.type, chunk.max, hi)) { return true; }
+			return _range_may_match(lo, hi, predicate.op, *d);
+		}
+
+		if (column.type != parquet_byte_array) { return true; }
+
+		const std::string_view lo = chunk.nulls != 0 ? std::string_view() : std::string_view(chunk.min);
+		return _range_may_match(lo, std::string_view(chunk.max), predicate.op, std::string_view(std::get<std::string>(predicate.value)));
+	}
+
+	static bool _test_value(const c_column& col, size_t row, const s_predicate& predicate)
+	{
+		if (const double* d = std::get_if<double>(&predicate.value))
+		{
+			const double v = col.type() == e_dtype::str ? _to_double(col.values<std::string>()[row]) : std::get<double>(col.get(row));
+			return _compare(v, predicate.op, *d);
+		}
+
+		const std::string& text = std::get<std::string>(predicate.value);
+		if (col.type() == e_dtype::str) { return _compare(std::string_view(col.values<std::string>()[row]), predicate.op, std::string_view(text)); }
+		return _compare(c_column::format_double(std::get<double>(col.get(row))), predicate.op, text);
+	}
+
+	/*
+	*	keeps the rows whose keep flag is set, in order, in one pass
+	*/
+	static void _compact(c_column& col, const std::vector<uint8_t>& keep, size_t kept)
+	{
+		col.visit([&](auto& v) {
+			size_t w = 0;
+			for (size_t i = 0; i < v.size(); ++i)
+			{
+				if (!keep[i]) { continue; }
+				if (w != i) { v[w] = std::move(v[i]); }
+				++w;
+			}
+			v.resize(kept);
+			});
+	}
+
+	/*
+	*	plain-encodes rows [from, to) of col; returns false when the column has no statistics (all NaN)
+	*/
+	static bool _plain_parquet_page(const c_column& col, size_t from, size_t to, std::vector<uint8_t>& page, std::string& min, std::string& max)
+	{
+		page.clear();
+		bool any = false;
+
+		col.visit([&](const auto& v) {
+			using t = typename std::decay_t<decltype(v)>::value_type;
+
+			auto raw = [](const auto& x) { return std::string(reinterpret_cast<const char*>(&x), sizeof(x)); };
+
+			if constexpr (std::is_same_v<t, std::string>)
+			{
+				const std::string* lo = nullptr;
+				const std::string* hi = nullptr;
+				for (size_t i = from; i < to; ++i)
+				{
+					const uint32_t length = static_cast<uint32_t>(v[i].size());
+					page.insert(page.end(), reinterpret_cast<const uint8_t*>(&length), reinterpret_cast<const uint8_t*>(&length) + 4);
+					page.insert(page.end(), v[i].begin(), v[i].end());
+
+					if (!lo || v[i] < *lo) { lo = &v[i]; }
+					if (!hi || *hi < v[i]) { hi = &v[i]; }
+				}
+				min = *lo;
+				max = *hi;
+				any = true;
+			}
+			else if constexpr (std::is_same_v<t, uint8_t>)
+			{
+				page.assign((to - from + 7) / 8, 0);
+				uint8_t lo = 1, hi = 0;
+				for (size_t i = from; i < to; ++i)
+				{
+					const uint8_t b = v[i] ? 1 : 0;
+					page[(i - from) >> 3] |= static_cast<uint8_t>(b << ((i - from) & 7));
+					lo = std::min(lo, b);
+					hi = std::max(hi, b);
+				}
+				min = raw(lo);
+				max = raw(hi);
+				any = true;
+			}
+			else
+			{
+				const uint8_t* p = reinterpret_cast<const uint8_t*>(v.data() + from);
+				page.assign(p, p + (to - from) * sizeof(t));
+
+				t lo = t(), hi = t();
+				for (size_t i = from; i < to; ++i)
+				{
+					if constexpr (std::is_floating_point_v<t>)
+					{
+						if (std::isnan(v[i])) { continue; }
+					}
+					if (!any || v[i] < lo) { lo = v[i]; }
+					if (!any || hi < v[i]) { hi = v[i]; }
+					any = true;
+				}
+				min = raw(lo);
+				max = raw(hi);
+			}
+			});
+
+		return any;
+	}
+
+	static constexpr size_t _parquet_page_bytes = size_t(1) << 28;
+
+	/*
+	*	end of the data page starting at row from: its PLAIN bytes stay within _parquet_page_bytes, with at least one row
+	*/
+	static size_t _parquet_page_end(const c_column& col, size_t from, size_t to)
+	{
+		return col.visit([&](const auto& v) {
+			using t = typename std::decay_t<decltype(v)>::value_type;
+
+			if constexpr (std::is_same_v<t, std::string>)
+			{
+				size_t bytes = 0, i = from;
+				for (; i < to; ++i)
+				{
+					bytes += 4 + v[i].size();
+					if (bytes > _parquet_page_bytes && i > from) { break; }
+				}
+				return i;
+			}
+			else if constexpr (std::is_same_v<t, uint8_t>) { return std::min(to, from + _parquet_page_bytes * 8); }
+			else { return std::min(to, from + _parquet_page_bytes / sizeof(t)); }
+			});
+	}
+
+	/*
+	*	widens the PLAIN encoded chunk min / max by those of one page
+	*/
+	static void _merge_parquet_stats(const c_column& col, const std::string& page_min, const std::string& page_max, std::string& min, std::string& max)
+	{
+		auto less = [&](const std::string& a, const std::string& b) {
+			auto decode = [](const std::string& x, auto v) { std::memcpy(&v, x.data(), sizeof(v)); return v; };
+			switch (col.type())
+			{
+			case e_dtype::f64: return decode(a, 0.0) < decode(b, 0.0);
+			case e_dtype::i64: return decode(a, int64_t(0)) < decode(b, int64_t(0));
+			case e_dtype::boolean: return decode(a, uint8_t(0)) < decode(b, uint8_t(0));
+			default: return a < b;
+			}
+			};
+
+		if (less(page_min, min)) { min = page_min; }
+		if (less(max, page_max)) { max = page_max; }
+	}
+
+	bool _append_column(const std::string& name, c_column values)
+	{
+		this->compact();
+
+		if (name.empty())
+		{
+			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
+			return false;
+		}
+
+		if (!values.size())
+		{
+			c_logger::get().log("[c_dataframe]: No values\n", LOG_CLR_RED);
+			return false;
+		}
+
+		if (this->m_rows == 0) { this->m_rows = values.size(); }
+		else if (values.size() != this->m_rows)
+		{
+			c_logger::get().log("[c_dataframe]: Row length mismatch: " + name + "\n", LOG_CLR_RED);
+			return false;
+		}
+
+		auto [it, inserted] = this->m_data.emplace(name, std::move(values));
+		if (!inserted)
+		{
+			c_logger::get().log("[c_dataframe]: Duplicate column name: " + name + "\n", LOG_CLR_RED);
+			return false;
+		}
+
+		return true;
+	}
+
+	const c_column* _find_range(const std::string& name, size_t& from, size_t& length) const
+	{
+		if (name.empty())
+		{
+			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
+			return nullptr;
+		}
+
+		auto it = this->m_data.find(name);
+		if (it == this->m_data.end()) { return nullptr; }
+
+		const size_t n = this->m_rows;
+		if (n == 0) { return nullptr; }
+
+		if (length == 0 || from + length > n) { length = n - from; }
+		if (from >= n || length == 0) { return nullptr; }
+
+		return &it->second;
+	}
+
+	/*
+	*	resolves the column type once and hands fn(const t* data, size_t n) whole typed spans; string columns are parsed in small stack chunks
+	*/
+	template<class fn_t>
+	static void _visit_numeric(const c_column& col, size_t from, size_t length, fn_t&& fn)
+	{
+		switch (col.type())
+		{
+		case e_dtype::f64: fn(col.data<double>() + from, length); return;
+		case e_dtype::i64: fn(col.data<int64_t>() + from, length); return;
+		case e_dtype::boolean: fn(col.data<uint8_t>() + from, length); return;
+		case e_dtype::str: break;
+		}
+
+		const auto& strs = col.values<std::string>();
+
+		double buffer[_parse_chunk];
+		for (size_t i = from; i < from + length; i += _parse_chunk)
+		{
+			const size_t k = std::min(_parse_chunk, from + length - i);
+			for (size_t j = 0; j < k; ++j) { buffer[j] = _to_double(strs[i + j]); }
+			fn(static_cast<const double*>(buffer), k);
+		}
+	}
+
+	template<class fn_t>
+	static void _visit_numeric(const c_column& col1, const c_column& col2, size_t from, size_t length, fn_t&& fn)
+	{
+		for (size_t i = from; i < from + length; i += _parse_chunk)
+		{
+			const size_t k = std::min(_parse_chunk, from + length - i);
+			_visit_numeric(col1, i, k, [&](const auto* p1, size_t) {
+				_visit_numeric(col2, i, k, [&](const auto* p2, size_t) { fn(p1, p2, k); });
+				});
+		}
+	}
+
+	static constexpr size_t _compact_min_rows = size_t(1) << 12;
+
+	bool _dense() const noexcept
+	{
+		return !this->m_start && !this->m_dead_rows;
+	}
+
+	bool _is_dead(size_t p) const noexcept
+	{
+		return (p >> 6) < this->m_dead.size() && ((this->m_dead[p >> 6] >> (p & 63)) & 1);
+	}
+
+	/*
+	*	first physical row at or after p that is dropped (dead) or live (!dead)
+	*/
+	size_t _next_row(size_t p, bool dead) const noexcept
+	{
+		size_t word = p >> 6;
+		if (word >= this->m_dead.size()) { return dead ? std::numeric_limits<size_t>::max() : p; }
+
+		uint64_t bits = (dead ? this->m_dead[word] : ~this->m_dead[word]) & (~uint64_t(0) << (p & 63));
+		while (!bits)
+		{
+			if (++word >= this->m_dead.size()) { return dead ? std::numeric_limits<size_t>::max() : word << 6; }
+			bits = dead ? this->m_dead[word] : ~this->m_dead[word];
+		}
+
+		return (word << 6) + n_simd::ctz(bits);
+	}
+
+	/*
+	*	physical row of live row index; O(1) unless rows in the middle were dropped, then a popcount scan of the bitmap
+	*/
+	size_t _physical(size_t index) const noexcept
+	{
+		if (!this->m_dead_rows) { return this->m_start + index; }
+
+		size_t word = this->m_start >> 6;
+		uint64_t bits = ~this->m_dead[word] & (~uint64_t(0) << (this->m_start & 63));
+		for (size_t count = n_simd::popcount(bits); index >= count; count = n_simd::popcount(bits))
+		{
+			index -= count;
+			bits = ++word < this->m_dead.size() ? ~this->m_dead[word] : ~uint64_t(0);
+		}
+
+		while (index--) { bits &= bits - 1; }
+		return (word << 6) + n_simd::ctz(bits);
+	}
+
+	/*
+	*	calls fn(physical row, count) for each run of consecutive live rows in live rows [from, from + length)
+	*/
+	template<class fn_t>
+	void _live_runs(size_t from, size_t length, fn_t&& fn) const
+	{
+		size_t p = this->_physical(from);
+		if (!this->m_dead_rows)
+		{
+			fn(p, length);
+			return;
+		}
+
+		while (length)
+		{
+			const size_t run = std::min(length, this->_next_row(p, true) - p);
+			fn(p, run);
+			length -= run;
+			if (length) { p = this->_next_row(p + run, false); }
+		}
+	}
+
+	/*
+	*	drops physical row p: the first and last rows only move the bounds, any other row is marked in the bitmap. once
+	*	dropped rows outnumber live ones the frame is compacted, so dropping in a loop stays amortized O(columns)
+	*/
+	void _drop_physical(size_t p)
+	{
+		const size_t physical = this->m_start + this->m_rows + this->m_dead_rows;
+		this->m_rows--;
+		for (auto& [name, col] : this->m_data) { col.touch(); }
+
+		auto revive = [this](size_t q) {
+			this->m_dead[q >> 6] &= ~(uint64_t(1) << (q & 63));
+			this->m_dead_rows--;
+			};
+
+		if (p + 1 == physical)
+		{
+			size_t n = 1;
+			while (this->m_dead_rows && this->_is_dead(p - n)) { revive(p - n++); }
+			for (auto& [name, col] : this->m_data) { col.truncate(n); }
+		}
+		else if (p == this->m_start)
+		{
+			++this->m_start;
+			while (this->m_dead_rows && this->_is_dead(this->m_start)) { revive(this->m_start++); }
+		}
+		else
+		{
+			if (this->m_dead.size() <= (p >> 6)) { this->m_dead.resize((physical + 63) / 64, 0); }
+			this->m_dead[p >> 6] |= uint64_t(1) << (p & 63);
+			this->m_dead_rows++;
+		}
+
+		if (!this->m_dead_rows) { this->m_dead.clear(); }
+		if (!this->m_rows || this->m_start + this->m_dead_rows > std::max(_compact_min_rows, this->m_rows)) { this->compact(); }
+	}
+
+	/*
+	*	dense copy of live rows [from, from + count)
+	*/
+	c_dataframe _rows(size_t from, size_t count) const
+	{
+		c_dataframe df;
+		for (const auto& [name, col] : this->m_data)
+		{
+			if (this->_dense())
+			{
+				df.m_data.emplace(name, col.slice(from, count));
+				continue;
+			}
+
+			df.m_data.emplace(name, col.visit([&](const auto& v) {
+				using t = typename std::decay_t<decltype(v)>::value_type;
+				std::vector<t> out;
+				out.reserve(count);
+				this->_live_runs(from, count, [&](size_t p, size_t k) { out.insert(out.end(), v.begin() + p, v.begin() + p + k); });
+				return c_column(std::move(out));
+				}));
+		}
+
+		df.m_rows = count;
+		return df;
+	}
+
+	/*
+	*	_visit_numeric over the live rows [from, from + length)
+	*/
+	template<class fn_t>
+	void _visit_live(const c_column& col, size_t from, size_t length, fn_t&& fn) const
+	{
+		this->_live_runs(from, length, [&](size_t p, size_t k) { _visit_numeric(col, p, k, fn); });
+	}
+
+	template<class fn_t>
+	void _visit_live(const c_column& col1, const c_column& col2, size_t from, size_t length, fn_t&& fn) const
+	{
+		this->_live_runs(from, length, [&](size_t p, size_t k) { _visit_numeric(col1, col2, p, k, fn); });
+	}
+
+	std::vector<double> _gather(const c_column& col, size_t from, size_t length) const
+	{
+		std::vector<double> vals;
+		vals.reserve(length);
+
+		this->_visit_live(col, from, length, [&](const auto* p, size_t k) {
+			for (size_t i = 0; i < k; ++i)
+			{
+				const double d = static_cast<double>(p[i]);
+				if (!std::isnan(d)) { vals.emplace_back(d); }
+			}
+			});
+
+		return vals;
+	}
+
+	template<class op_t>
+	std::vector<double> _gather(const c_column& col1, const c_column& col2, size_t from, size_t length, op_t&& op) const
+	{
+		std::vector<double> vals;
+		vals.reserve(length);
+
+		this->_visit_live(col1, col2, from, length, [&](const auto* p1, const auto* p2, size_t k) {
+			for (size_t i = 0; i < k; ++i)
+			{
+				const double d1 = static_cast<double>(p1[i]);
+				const double d2 = static_cast<double>(p2[i]);
+				if (!std::isnan(d1) && !std::isnan(d2)) { vals.emplace_back(op(d1, d2)); }
+			}
+			});
+
+		return vals;
+	}
+
+	/*
+	*	one fused pass over the non-NaN values of live rows [from, from + length): each value is read (strings parsed in
+	*	stack chunks), combined with the previous value and handed to emit. with aligned every NaN row emits NaN too, so
+	*	the output lines up with the rows. cumsum / cumprod go through _cumulative instead
+	*/
+	template<e_transform op, class emit_t>
+	void _transform(const c_column& col, size_t from, size_t length, bool aligned, emit_t&& emit) const
+	{
+		bool first = true;
+		double prev = 0.0;
+		this->_visit_live(col, from, length, [&](const auto* p, size_t k) {
+			for (size_t i = 0; i < k; ++i)
+			{
+				const double x = static_cast<double>(p[i]);
+				if (std::isnan(x))
+				{
+					if (aligned) { emit(x); }
+					continue;
+				}
+
+				if (first) { emit(std::numeric_limits<double>::quiet_NaN()); }
+				else if constexpr (op == e_transform::diff) { emit(x - prev); }
+				else if constexpr (op == e_transform::pct_change) { emit(n_math::relative_change(x, prev)); }
+				else { emit(n_math::log_relative_change(x, prev)); }
+
+				prev = x;
+				first = false;
+			}
+			});
+	}
+
+	template<class emit_t>
+	void _transform(const c_column& col, size_t from, size_t length, e_transform op, bool aligned, emit_t&& emit) const
+	{
+		switch (op)
+		{
+		case e_transform::diff: this->_transform<e_transform::diff>(col, from, length, aligned, emit); return;
+		case e_transform::pct_change: this->_transform<e_transform::pct_change>(col, from, length, aligned, emit); return;
+		case e_transform::log_change: this->_transform<e_transform::log_change>(col, from, length, aligned, emit); return;
+		default: return;
+		}
+	}
+
+	/*
+	*	where each block of _reduce_block_rows live rows starts writing its scan: at its first row when aligned, otherwise
+	*	after the non-NaN values of the blocks before it, counted in parallel (int64 and bool blocks have none to skip)
+	*/
+	std::vector<size_t> _scan_offsets(const c_column& col, size_t from, size_t length, bool aligned) const
+	{
+		const size_t blocks = (length + _reduce_block_rows - 1) / _reduce_block_rows;
+		const bool count = !aligned && (col.type() == e_dtype::f64 || col.type() == e_dtype::str);
+
+		std::vector<size_t> offsets(blocks + 1, 0);
+		c_thread_pool::get().parallel_for(blocks, [&](size_t b) {
+			const size_t begin = from + b * _reduce_block_rows;
+			const size_t k = std::min(_reduce_block_rows, from + length - begin);
+			if (!count)
+			{
+				offsets[b + 1] = k;
+				return;
+			}
+
+			size_t n = 0;
+			this->_visit_live(col, begin, k, [&](const auto* p, size_t m) {
+				for (size_t i = 0; i < m; ++i) { n += !std::isnan(static_cast<double>(p[i])); }
+				});
+			offsets[b + 1] = n;
+			});
+
+		for (size_t b = 0; b < blocks; ++b) { offsets[b + 1] += offsets[b]; }
+		return offsets;
+	}
+
+	/*
+	*	running op over a span of one block, NaN values skipped (written through when aligned); returns the next output
+	*/
+	template<class t, class op_t>
+	static double* _scan_span(const t* p, size_t k, double* out, double& total, bool& seen, bool aligned, op_t&& op)
+	{
+		for (size_t i = 0; i < k; ++i)
+		{
+			const double x = static_cast<double>(p[i]);
+			if (std::isnan(x))
+			{
+				if (aligned) { *out++ = x; }
+				continue;
+			}
+
+			total = seen ? op(total, x) : x;
+			seen = true;
+			*out++ = total;
+		}
+
+		return out;
+	}
+
+	/*
+	*	blocked parallel inclusive scan with an associative op over live rows [from, from + length), laid out by
+	*	_scan_offsets: every block is scanned on its own in parallel by local(p, k, out, total, seen, dense) (dense: the
+	*	block has no NaN to skip), the block totals are combined in order, and a fix-up pass applies op(carry, x) to the
+	*	output of each block after the first value. the blocks are fixed, so the result does not depend on the thread count
+	*/
+	template<class op_t, class local_t>
+	void _scan(const c_column& col, size_t from, size_t length, const std::vector<size_t>& offsets, double* out, op_t&& op, local_t&& local) const
+	{
+		const size_t blocks = offsets.size() - 1;
+		std::vector<double> totals(blocks, 0.0);
+		std::vector<uint8_t> any(blocks, 0);
+
+		c_thread_pool::get().parallel_for(blocks, [&](size_t b) {
+			const size_t begin = from + b * _reduce_block_rows;
+			const size_t k = std::min(_reduce_block_rows, from + length - begin);
+			const bool dense = offsets[b + 1] - offsets[b] == k;
+
+			double* o = out + offsets[b];
+			double total = 0.0;
+			bool seen = false;
+			this->_visit_live(col, begin, k, [&](const auto* p, size_t m) { o = local(p, m, o, total, seen, dense); });
+			totals[b] = total;
+			any[b] = seen;
+			});
+
+		std::vector<double> carries(blocks, 0.0);
+		std::vector<uint8_t> carried(blocks, 0);
+		double carry = 0.0;
+		bool seen = false;
+		for (size_t b = 0; b < blocks; ++b)
+		{
+			carries[b] = carry;
+			carried[b] = seen;
+			if (!any[b]) { continue; }
+
+			carry = seen ? op(carry, totals[b]) : totals[b];
+			seen = true;
+		}
+
+		c_thread_pool::get().parallel_for(blocks, [&](size_t b) {
+			if (!carried[b]) { return; }
+
+			const double c = carries[b];
+			for (size_t i = offsets[b]; i < offsets[b + 1]; ++i) { out[i] = op(c, out[i]); }
+			});
+	}
+
+	/*
+	*	cumsum / cumprod through _scan; double spans without NaN to skip (or aligned) run the n_simd scan kernels
+	*/
+	template<class op_t>
+	void _cumulative(const c_column& col, size_t from, size_t length, const std::vector<size_t>& offsets, bool aligned, double* out, n_simd::scan_kernel_t kernel, double identity, op_t op) const
+	{
+		this->_scan(col, from, length, offsets, out, op, [&](const auto* p, size_t k, double* o, double& total, bool& seen, bool dense) {
+			if constexpr (std::is_same_v<std::decay_t<decltype(*p)>, double>)
+			{
+				if (dense)
+				{
+					total = kernel(p, o, k, seen ? total : identity);
+					seen = true;
+					return o + k;
+				}
+			}
+
+			return _scan_span(p, k, o, total, seen, aligned, op);
+			});
+	}
+
+	void _cumulative(const c_column& col, size_t from, size_t length, e_transform op, bool aligned, double* out, const std::vector<size_t>& offsets) const
+	{
+		if (op == e_transform::cumsum) { this->_cumulative(col, from, length, offsets, aligned, out, n_simd::scan_f64().sum, -0.0, std::plus<double>()); }
+		else { this->_cumulative(col, from, length, offsets, aligned, out, n_simd::scan_f64().prod, 1.0, std::multiplies<double>()); }
+	}
+
+	/*
+	*	double spans (f64 columns and parsed string chunks) go through the n_simd reduction kernels; int64 and bool spans
+	*	have no NaN to skip
+	*/
+	template<class t>
+	static double _span_sum(const t* p, size_t k)
+	{
+		if constexpr (std::is_same_v<t, double>) { return n_simd::reduce_f64().sum(p, k); }
+		else
+		{
+			double sum = 0.0;
+			for (size_t i = 0; i < k; ++i) { sum += static_cast<double>(p[i]); }
+			return sum;
+		}
+	}
+
+	template<class t>
+	static double _span_prod(const t* p, size_t k)
+	{
+		if constexpr (std::is_same_v<t, double>) { return n_simd::reduce_f64().prod(p, k); }
+		else
+		{
+			double prod = 1.0;
+			for (size_t i = 0; i < k; ++i) { prod *= static_cast<double>(p[i]); }
+			return prod;
+		}
+	}
+
+	template<class t>
+	static double _span_min(const t* p, size_t k, double min)
+	{
+		if constexpr (std::is_same_v<t, double>) { return n_simd::reduce_f64().min(p, k, min); }
+		else
+		{
+			for (size_t i = 0; i < k; ++i) { min = std::min(min, static_cast<double>(p[i])); }
+			return min;
+		}
+	}
+
+	template<class t>
+	static double _span_max(const t* p, size_t k, double max)
+	{
+		if constexpr (std::is_same_v<t, double>) { return n_simd::reduce_f64().max(p, k, max); }
+		else
+		{
+			for (size_t i = 0; i < k; ++i) { max = std::max(max, static_cast<double>(p[i])); }
+			return max;
+		}
+	}
+
+	template<class t>
+	static void _span_var(const t* p, size_t k, size_t& n, double& mean, double& m2)
+	{
+		if constexpr (std::is_same_v<t, double>) { n_simd::reduce_f64().var(p, k, n, mean, m2); }
+		else
+		{
+			for (size_t i = 0; i < k; ++i)
+			{
+				const double d = static_cast<double>(p[i]);
+				++n;
+				const double delta = d - mean;
+				mean += delta / static_cast<double>(n);
+				m2 += delta * (d - mean);
+			}
+		}
+	}
+
+	enum class e_stat : uint8_t
+	{
+		sum,
+		prod,
+		var,
+		min,
+		max,
+		skew,
+		kurt
+	};
+
+	/*
+	*	single-column statistics are cached in the column against its version, so repeated queries on unchanged data are O(1).
+	*	mean shares the sum entry and std the var entry
+	*/
+	template<class fn_t>
+	static double _cached(const c_column& col, e_stat stat, size_t from, size_t length, fn_t&& fn)
+	{
+		double value = 0.0;
+		if (col.stats().find(static_cast<uint8_t>(stat), from, length, col.version(), value)) { return value; }
+
+		value = fn();
+		col.stats().store(static_cast<uint8_t>(stat), from, length, col.version(), value);
+		return value;
+	}
+
+	static constexpr size_t _reduce_block_rows = size_t(1) << 16;
+
+	/*
+	*	splits the live rows [from, from + length) into fixed _reduce_block_rows blocks reduced in parallel by
+	*	fn(acc_t& partial, from, length); partials are merged in block order, so the result does not depend on the thread count
+	*/
+	template<class acc_t, class fn_t, class merge_t>
+	acc_t _reduce_blocks(size_t from, size_t length, fn_t&& fn, merge_t&& merge, const acc_t& init = acc_t{}) const
+	{
+		const size_t blocks = (length + _reduce_block_rows - 1) / _reduce_block_rows;
+
+		std::vector<acc_t> partials(blocks, init);
+		c_thread_pool::get().parallel_for(blocks, [&](size_t b) {
+			const size_t begin = from + b * _reduce_block_rows;
+			fn(partials[b], begin, std::min(_reduce_block_rows, from + length - begin));
+			});
+
+		acc_t acc = init;
+		for (size_t b = 0; b < blocks; ++b) { merge(acc, partials[b]); }
+		return acc;
+	}
+
+	/*
+	*	the column's range index while it is current and the live rows are contiguous
+	*/
+	const c_range_index* _range_index(const c_column& col) const noexcept
+	{
+		return this->m_dead_rows ? nullptr : col.index();
+	}
+
+	/*
+	*	sum, var, min or max of live rows [from, from + length) from a current range index
+	*/
+	double _indexed(const c_range_index& index, const c_column& col, e_stat stat, size_t from, size_t length) const
+	{
+		const size_t a = this->m_start + from;
+		switch (stat)
+		{
+		case e_stat::sum: return index.sum(a, a + length);
+		case e_stat::var: return index.var(a, a + length);
+		case e_stat::min:
+		case e_stat::max:
+			return col.visit([&](const auto& v) {
+				if constexpr (std::is_same_v<typename std::decay_t<decltype(v)>::value_type, std::string>) { return std::numeric_limits<double>::quiet_NaN(); }
+				else { return stat == e_stat::min ? index.min(v, a, a + length) : index.max(v, a, a + length); }
+				});
+		default: return std::numeric_limits<double>::quiet_NaN();
+		}
+	}
+
+	/*
+	*	_reduce_blocks over several columns at once: every (row block, column) pair is one task of a single parallel_for,
+	*	so small columns share the pool instead of each waiting on its own, and each column's partials are merged in block
+	*	order exactly as _reduce_blocks merges them
+	*/
+	template<class acc_t, class fn_t, class merge_t>
+	std::vector<acc_t> _reduce_columns(const std::vector<const c_column*>& cols, size_t from, size_t length, fn_t&& fn, merge_t&& merge, const acc_t& init = acc_t{}) const
+	{
+		const size_t blocks = (length + _reduce_block_rows - 1) / _reduce_block_rows;
+
+		std::vector<acc_t> partials(blocks * cols.size(), init);
+		c_thread_pool::get().parallel_for(partials.size(), [&](size_t t) {
+			const size_t begin = from + (t / cols.size()) * _reduce_block_rows;
+			fn(*cols[t % cols.size()], partials[t], begin, std::min(_reduce_block_rows, from + length - begin));
+			});
+
+		std::vector<acc_t> out(cols.size(), init);
+		for (size_t b = 0; b < blocks; ++b)
+		{
+			for (size_t c = 0; c < cols.size(); ++c) { merge(out[c], partials[b * cols.size() + c]); }
+		}
+
+		return out;
+	}
+
+	/*
+	*	sum, var, min or max of each named column over the same rows (NaN for a missing column); length is resolved like
+	*	_find_range does. indexed and cached columns are answered directly, the others reduced together and cached
+	*/
+	std::vector<double> _batch(const std::vector<std::string>& names, size_t from, size_t& length, e_stat stat) const
+	{
+		std::vector<double> out(names.size(), std::numeric_limits<double>::quiet_NaN());
+
+		std::vector<const c_column*> cols;
+		std::vector<size_t> slots;
+		const size_t requested = length;
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			size_t range = requested;
+			const c_column* col = this->_find_range(names[i], from, range);
+			if (!col) { continue; }
+
+			length = range;
+			if (stat == e_stat::var && length < 2) { out[i] = 0.0; }
+			else if (const c_range_index* index = this->_range_index(*col)) { out[i] = this->_indexed(*index, *col, stat, from, length); }
+			else if (!col->stats().find(static_cast<uint8_t>(stat), from, length, col->version(), out[i]))
+			{
+				cols.push_back(col);
+				slots.push_back(i);
+			}
+		}
+
+		if (cols.empty()) { return out; }
+
+		std::vector<double> values;
+		switch (stat)
+		{
+		case e_stat::sum:
+			values = this->_reduce_columns<double>(cols, from, length,
+				[&](const c_column& col, double& sum, size_t f, size_t l) { this->_visit_live(col, f, l, [&](const auto* p, size_t k) { sum += _span_sum(p, k); }); },
+				[](double& acc, double sum) { acc += sum; });
+			break;
+		case e_stat::var:
+			for (const n_math::s_moments& m : this->_reduce_columns<n_math::s_moments>(cols, from, length,
+				[&](const c_column& col, n_math::s_moments& part, size_t f, size_t l) { this->_visit_live(col, f, l, [&](const auto* p, size_t k) { _span_var(p, k, part.n, part.mean, part.m2); }); },
+				[](n_math::s_moments& acc, const n_math::s_moments& part) { acc.merge(part); }))
+			{
+				values.push_back(m.m2 / static_cast<double>(length - 1));
+			}
+			break;
+		case e_stat::min:
+			values = this->_reduce_columns<double>(cols, from, length,
+				[&](const c_column& col, double& min, size_t f, size_t l) { this->_visit_live(col, f, l, [&](const auto* p, size_t k) { min = _span_min(p, k, min); }); },
+				[](double& acc, double min) { acc = std::min(acc, min); }, std::numeric_limits<double>::infinity());
+			break;
+		case e_stat::max:
+			values = this->_reduce_columns<double>(cols, from, length,
+				[&](const c_column& col, double& max, size_t f, size_t l) { this->_visit_live(col, f, l, [&](const auto* p, size_t k) { max = _span_max(p, k, max); }); },
+				[](double& acc, double max) { acc = std::max(acc, max); }, -std::numeric_limits<double>::infinity());
+			break;
+		default: return out;
+		}
+
+		for (size_t c = 0; c < cols.size(); ++c)
+		{
+			cols[c]->stats().store(static_cast<uint8_t>(stat), from, length, cols[c]->version(), values[c]);
+			out[slots[c]] = values[c];
+		}
+
+		return out;
+	}
+
+	double _sum(const c_column& col, size_t from, size_t length) const
+	{
+		return this->_reduce_blocks<double>(from, length,
+			[&](double& sum, size_t f, size_t l) { this->_visit_live(col, f, l, [&](const auto* p, size_t k) { sum += _span_sum(p, k); }); },
+			[](double& acc, double sum) { acc += sum; });
+	}
+
+	double _var(const c_column& col, size_t from, size_t length) const
+	{
+		if (length < 2) { return 0.0; }
+
+		if (const c_range_index* index = this->_range_index(col)) { return this->_indexed(*index, col, e_stat::var, from, length); }
+
+		return _cached(col, e_stat::var, from, length, [&]() {
+			const n_math::s_moments m = this->_reduce_blocks<n_math::s_moments>(from, length,
+				[&](n_math::s_moments& part, size_t f, size_t l) { this->_visit_live(col, f, l, [&](const auto* p, size_t k) { _span_var(p, k, part.n, part.mean, part.m2); }); },
+				[](n_math::s_moments& acc, const n_math::s_moments& part) { acc.merge(part); });
+
+			return m.m2 / static_cast<double>(length - 1);
+			});
+	}
+
+	/*
+	*	places the values of the sorted, distinct ranks (offset by the rank of first) where a full sort would: each
+	*	nth_element splits the range, and the ranks on either side are selected within their part
+	*/
+	static void _select(double* first, double* last, const size_t* rank_first, const size_t* rank_last, size_t offset)
+	{
+		if (rank_first == rank_last) { return; }
+
+		const size_t* mid = rank_first + (rank_last - rank_first) / 2;
+		double* nth = first + (*mid - offset);
+		std::nth_element(first, nth, last);
+
+		_select(first, nth, rank_first, mid, offset);
+		_select(nth + 1, last, mid + 1, rank_last, *mid + 1);
+	}
+
+	/*
+	*	exact quantiles of the non-NaN values, linearly interpolated between the two closest ranks; one copy of the range,
+	*	then one multi-rank selection for all of qs
+	*/
+	std::vector<double> _quantiles(const c_column& col, size_t from, size_t length, const std::vector<double>& qs) const
+	{
+		std::vector<double> out(qs.size(), std::numeric_limits<double>::quiet_NaN());
+
+		std::vector<double> values;
+		values.reserve(length);
+		this->_visit_live(col, from, length, [&](const auto* p, size_t k) {
+			for (size_t i = 0; i < k; ++i)
+			{
+				const double x = static_cast<double>(p[i]);
+				if (!std::isnan(x)) { values.push_back(x); }
+			}
+			});
+
+		if (values.empty()) { return out; }
+
+		const double last = static_cast<double>(values.size() - 1);
+		std::vector<size_t> ranks;
+		for (double q : qs)
+		{
+			if (!(q >= 0.0 && q <= 1.0)) { continue; }
+
+			const size_t lo = static_cast<size_t>(std::floor(q * last));
+			ranks.push_back(lo);
+			if (static_cast<double>(lo) < q * last) { ranks.push_back(lo + 1); }
+		}
+
+		std::sort(ranks.begin(), ranks.end());
+		ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+		_select(values.data(), values.data() + values.size(), ranks.data(), ranks.data() + ranks.size(), 0);
+
+		for (size_t i = 0; i < qs.size(); ++i)
+		{
+			if (!(qs[i] >= 0.0 && qs[i] <= 1.0)) { continue; }
+
+			const double pos = qs[i] * last;
+			const size_t lo = static_cast<size_t>(std::floor(pos));
+			const double frac = pos - static_cast<double>(lo);
+			out[i] = frac > 0.0 ? values[lo] + (values[lo + 1] - values[lo]) * frac : values[lo];
+		}
+
+		return out;
+	}
+
+	n_math::s_moments _moments(const c_column& col, size_t from, size_t length) const
+	{
+		return this->_reduce_blocks<n_math::s_moments>(from, length,
+			[&](n_math::s_moments& part, size_t f, size_t l) { this->_visit_live(col, f, l, [&](const auto* p, size_t k) { part.add(p, k); }); },
+			[](n_math::s_moments& acc, const n_math::s_moments& part) { acc.merge(part); });
+	}
+
+	/*
+	*	the existing reductions divide by the range length (NaN rows included) and skew/kurt center on sum / length, so the
+	*	third and fourth moments are shifted from the mean of the values to that center
+	*/
+	s_stats _describe(const c_column& col, size_t from, size_t length) const
+	{
+		const n_math::s_moments m = this->_moments(col, from, length);
+
+		const double len = static_cast<double>(length);
+		const double n = static_cast<double>(m.n);
+
+		s_stats stats;
+		stats.count = m.n;
+		stats.sum = m.sum;
+		stats.mean = m.sum / len;
+		stats.var = length < 2 ? 0.0 : m.m2 / (len - 1.0);
+		stats.std = std::sqrt(stats.var);
+		stats.min = m.min;
+		stats.max = m.max;
+
+		if (!m.n)
+		{
+			stats.skew = 0.0;
+			stats.kurt = -3.0;
+			return stats;
+		}
+
+		const double d = m.mean - stats.mean;
+		const double d2 = d * d;
+		const double c3 = m.m3 + 3.0 * d * m.m2 + n * d2 * d;
+		const double c4 = m.m4 + 4.0 * d * m.m3 + 6.0 * d2 * m.m2 + n * d2 * d2;
+		const double s2 = stats.std * stats.std;
+
+		stats.skew = c3 / (s2 * stats.std) / len;
+		stats.kurt = c4 / (s2 * s2) / len - 3.0;
+		return stats;
+	}
+
+	static constexpr size_t _gram_block_rows = 512;
+
+	/*
+	*	n x n sums of products of the columns over the live rows [from, from + length), each centered on sum / length with
+	*	NaN as 0 so a pair only sums the rows where both values are set, like cov. rows are centered once into blocks of
+	*	_gram_block_rows (a 4-column panel stays in L1) and the upper triangle of each block's gram product is accumulated in
+	*	4 x 4 tiles. the range is split into one part per pool thread with its own matrix, merged in order
+	*/
+	std::vector<double> _comoment_matrix(const std::vector<const c_column*>& cols, size_t from, size_t length) const
+	{
+		const size_t n = cols.size();
+		const size_t np = (n + 3) & ~size_t(3);
+
+		std::vector<double> means(n);
+		for (size_t c = 0; c < n; ++c)
+		{
+			means[c] = _cached(*cols[c], e_stat::sum, from, length, [&]() { return this->_sum(*cols[c], from, length); }) / static_cast<double>(length);
+		}
+
+		const size_t parts = std::max<size_t>(1, std::min(c_thread_pool::get().size(), length / _gram_block_rows));
+		std::vector<std::vector<double>> partials(parts);
+		const n_simd::gram_kernel_t gram = n_simd::gram_4x4();
+
+		c_thread_pool::get().parallel_for(parts, [&](size_t t) {
+			const size_t begin = from + length * t / parts;
+			const size_t end = from + length * (t + 1) / parts;
+
+			std::vector<double> block(np * _gram_block_rows);
+			std::vector<double>& g = partials[t];
+			g.assign(np * np, 0.0);
+
+			for (size_t b = begin; b < end; b += _gram_block_rows)
+			{
+				const size_t rows = std::min(_gram_block_rows, end - b);
+				const size_t stride = (rows + 3) & ~size_t(3);
+
+				for (size_t c = 0; c < n; ++c)
+				{
+					double* dst = block.data() + c * stride;
+					const double mean = means[c];
+					this->_visit_live(*cols[c], b, rows, [&](const auto* p, size_t k) {
+						for (size_t i = 0; i < k; ++i)
+						{
+							const double d = static_cast<double>(p[i]);
+							*dst++ = std::isnan(d) ? 0.0 : d - mean;
+						}
+						});
+					std::fill(dst, block.data() + (c + 1) * stride, 0.0);
+				}
+				std::fill(block.data() + n * stride, block.data() + np * stride, 0.0);
+
+				for (size_t i = 0; i < np; i += 4)
+				{
+					for (size_t j = i; j < np; j += 4) { gram(block.data(), stride, i, j, g.data(), np); }
+				}
+			}
+			});
+
+		std::vector<double> m(n * n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			for (size_t j = i; j < n; ++j)
+			{
+				double sum = 0.0;
+				for (size_t t = 0; t < parts; ++t) { sum += partials[t][i * np + j]; }
+				m[i * n + j] = m[j * n + i] = sum;
+			}
+		}
+		return m;
+	}
+
+	/*
+	*	names empty selects every numeric column; the names label the rows of the matrix frame in its "column" column
+	*/
+	std::vector<const c_column*> _matrix_columns(std::vector<std::string>& names, size_t& from, size_t& length) const
+	{
+		if (names.empty())
+		{
+			for (const auto& [name, col] : this->m_data)
+			{
+				if (col.is_numeric()) { names.push_back(name); }
+			}
+		}
+
+		std::vector<const c_column*> cols;
+		for (const auto& name : names)
+		{
+			const c_column* col = this->_find_range(name, from, length);
+			if (!col || name == "column" || std::count(names.begin(), names.end(), name) > 1)
+			{
+				c_logger::get().log("[c_dataframe]: Invalid matrix column: " + name + "\n", LOG_CLR_RED);
+				return {};
+			}
+			cols.push_back(col);
+		}
+		return cols;
+	}
+
+	static c_dataframe _matrix_frame(const std::vector<std::string>& names, const std::vector<double>& m)
+	{
+		const size_t n = names.size();
+
+		c_dataframe df;
+		df.add_column("column", names);
+		for (size_t c = 0; c < n; ++c)
+		{
+			std::vector<double> values(n);
+			for (size_t r = 0; r < n; ++r) { values[r] = m[r * n + c]; }
+			df.add_column(names[c], std::move(values));
+		}
+		return df;
+	}
+
+	static constexpr size_t _mask_block_rows = size_t(1) << 16;
+
+	/*
+	*	sets bit i of out when row from + i satisfies the predicate; double, int and bool columns compared against a number run
+	*	the bitmask kernels, the rest goes through _test_value
+	*/
+	static void _compare_rows(const c_column& col, size_t from, size_t n, const s_predicate& predicate, uint64_t* out)
+	{
+		if (const double* d = std::get_if<double>(&predicate.value))
+		{
+			switch (col.type())
+			{
+			case e_dtype::f64: n_simd::compare_f64()(col.data<double>() + from, n, predicate.op, *d, out); return;
+			case e_dtype::i64: n_simd::compare_scalar(col.data<int64_t>() + from, n, predicate.op, *d, out); return;
+			case e_dtype::boolean: n_simd::compare_scalar(col.data<uint8_t>() + from, n, predicate.op, *d, out); return;
+			case e_dtype::str: break;
+			}
+		}
+
+		std::fill_n(out, (n + 63) / 64, uint64_t(0));
+		for (size_t i = 0; i < n; ++i)
+		{
+			if (_test_value(col, from + i, predicate)) { out[i >> 6] |= uint64_t(1) << (i & 63); }
+		}
+	}
+
+	/*
+	*	ors n bits into out starting at bit at; bits past n must be clear
+	*/
+	static void _or_bits(uint64_t* out, size_t at, const uint64_t* bits, size_t n)
+	{
+		uint64_t* dst = out + (at >> 6);
+		const unsigned shift = at & 63;
+
+		for (size_t w = 0; w < (n + 63) / 64; ++w)
+		{
+			dst[w] |= bits[w] << shift;
+			if (shift && (bits[w] >> (64 - shift))) { dst[w + 1] |= bits[w] >> (64 - shift); }
+		}
+	}
+
+	static constexpr size_t _drop_block_rows = size_t(1) << 16;
+
+	template<class pred_t>
+	bool _drop_rows_where(pred_t&& pred)
+	{
+		if (!this->m_rows) { return false; }
+
+		this->compact();
+
+		std::vector<c_column*> columns;
+		for (auto& [name, col] : this->m_data) { columns.push_back(&col); }
+
+		/*
+		*	one keep mask for the whole frame, row blocks are scanned in parallel across every column, then each column is
+		*	compacted once, in parallel across columns
+		*/
+		std::vector<uint8_t> keep(this->m_rows, 1);
+		const size_t blocks = (this->m_rows + _drop_block_rows - 1) / _drop_block_rows;
+		std::vector<size_t> kept(blocks, 0);
+
+		c_thread_pool::get().parallel_for(blocks, [&](size_t b) {
+			const size_t from = b * _drop_block_rows;
+			const size_t to = std::min(this->m_rows, from + _drop_block_rows);
+
+			for (const c_column* col : columns)
+			{
+				col->visit([&](const auto& v) {
+					for (size_t i = from; i < to; ++i)
+					{
+						if (keep[i] && pred(v[i])) { keep[i] = 0; }
+					}
+					});
+			}
+
+			for (size_t i = from; i < to; ++i) { kept[b] += keep[i]; }
+			});
+
+		size_t total = 0;
+		for (size_t k : kept) { total += k; }
+
+		if (total == this->m_rows) { return false; }
+
+		c_thread_pool::get().parallel_for(columns.size(), [&](size_t c) { _compact(*columns[c], keep, total); });
+		this->m_rows = total;
+
+		return true;
+	}
+
+public:
+
+	friend class c_csv_reader;
+	friend class c_csv_bench;
+
+	c_dataframe() = default;
+
+	explicit c_dataframe(const std::string& csv_path, bool header = true)
+	{
+		this->from_csv(csv_path, header);
+	}
+
+	c_dataframe(const std::string& csv_path, const s_csv_options& options)
+	{
+		this->from_csv(csv_path, options);
+	}
+
+	~c_dataframe() {}
+
+	bool add_column(const std::string& name, const std::vector<value_t>& values)
+	{
+		return this->_append_column(name, _to_column(values));
+	}
+
+	template<class t>
+	bool add_column(const std::string& name, const std::vector<t>& values);
+
+	template<class t>
+	bool add_column(const std::string& name, std::vector<t>&& values);
+
+	bool remove_column(const std::string& name)
+	{
+		if (name.empty())
+		{
+			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
+			return false;
+		}
+
+		const size_t erased = this->m_data.erase(name);
+		if (erased && this->m_data.empty()) { this->reset(); }
+
+		return erased != 0;
+	}
+
+	bool remove_column(const std::vector<std::string>& names)
+	{
+		if (names.empty())
+		{
+			c_logger::get().log("[c_dataframe]: No column names\n", LOG_CLR_RED);
+			return false;
+		}
+
+		for (const auto& k : names)
+		{
+			this->m_data.erase(k);
+		}
+
+		if (this->m_data.empty()) { this->reset(); }
+
+		return true;
+	}
+
+	bool rename_column(const std::string& old_name, const std::string& new_name)
+	{
+		if (old_name.empty() || new_name.empty())
+		{
+			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
+			return false;
+		}
+
+		auto it = m_data.find(old_name);
+		if (it == m_data.end())
+		{
+			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
+			return false;
+		}
+
+		if (m_data.find(new_name) != m_data.end())
+		{
+			c_logger::get().log("[c_dataframe]: Duplicate column name: " + new_name + "\n", LOG_CLR_RED);
+			return false;
+		}
+
+		m_data.emplace(new_name, std::move(it->second)).first->second.touch();
+		m_data.erase(it);
+
+		return true;
+	}
+
+	/*
+	*	dropf and dropb are O(1), drop(index) marks the row in a bitmap; the rows stay in the column buffers until compact()
+	*/
+	bool dropf()
+	{
+		if (!this->m_rows) { return false; }
+
+		this->_drop_physical(this->m_start);
+		return true;
+	}
+
+	bool dropb()
+	{
+		if (!this->m_rows) { return false; }
+
+		this->_drop_physical(this->m_start + this->m_rows + this->m_dead_rows - 1);
+		return true;
+	}
+
+	bool drop(size_t index)
+	{
+		if (!this->m_rows || index >= this->m_rows) { return false; }
+
+		this->_drop_physical(this->_physical(index));
+		return true;
+	}
+
+	/*
+	*	erases the rows dropped by drop / dropf / dropb from every column buffer, in parallel across columns. called
+	*	automatically once dropped rows outnumber live ones and before a column is handed out or added
+	*/
+	void compact()
+	{
+		if (this->_dense()) { return; }
+
+		std::vector<uint8_t> keep(this->m_start + this->m_rows + this->m_dead_rows, 0);
+		if (this->m_rows) { this->_live_runs(0, this->m_rows, [&](size_t p, size_t k) { std::fill_n(keep.begin() + p, k, uint8_t(1)); }); }
+
+		std::vector<c_column*> columns;
+		for (auto& [name, col] : this->m_data) { columns.push_back(&col); }
+		c_thread_pool::get().parallel_for(columns.size(), [&](size_t c) { _compact(*columns[c], keep, this->m_rows); });
+
+		this->m_start = 0;
+		this->m_dead_rows = 0;
+		this->m_dead.clear();
+	}
+
+	/*
+	*	opt-in range index for a numeric column: sum, mean, var, std, min and max of any range then answer in O(1) instead
+	*	of scanning. append() extends it; any other change to the column leaves it stale until it is built again
+	*/
+	bool build_index(const std::string& name)
+	{
+		this->compact();
+
+		auto it = this->m_data.find(name);
+		if (it == this->m_data.end())
+		{
+			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
+			return false;
+		}
+
+		c_column& col = it->second;
+		if (!col.is_numeric())
+		{
+			c_logger::get().log("[c_dataframe]: Column is not numeric: " + name + "\n", LOG_CLR_RED);
+			return false;
+		}
+
+		auto index = std::make_shared<c_range_index>();
+		_visit_numeric(col, 0, col.size(), [&](const auto* p, size_t k) { index->append(p, k); });
+		index->set_version(col.version());
+		col.index_ptr() = std::move(index);
+
+		return true;
+	}
+
+	void drop_index(const std::string& name)
+	{
+		auto it = this->m_data.find(name);
+		if (it != this->m_data.end()) { it->second.index_ptr().reset(); }
+	}
+
+	/*
+	*	appends the live rows of a frame with the same column names. a numeric column appends to a double column, other
+	*	types must match; current range indexes are extended by the new rows instead of going stale. the rows go after the
+	*	last physical row and dropped rows stay dropped, so appending at the back while dropping at the front never compacts
+	*/
+	bool append(const c_dataframe& rows)
+	{
+		if (!rows.m_rows)
+		{
+			c_logger::get().log("[c_dataframe]: No values\n", LOG_CLR_RED);
+			return false;
+		}
+
+		if (this->m_data.empty())
+		{
+			*this = rows._rows(0, rows.m_rows);
+			return true;
+		}
+
+		if (rows.m_data.size() != this->m_data.size())
+		{
+			c_logger::get().log("[c_dataframe]: Column count mismatch\n", LOG_CLR_RED);
+			return false;
+		}
+
+		for (const auto& [name, col] : this->m_data)
+		{
+			auto it = rows.m_data.find(name);
+			if (it == rows.m_data.end() || (it->second.type() != col.type() && !(col.type() == e_dtype::f64 && it->second.is_numeric())))
+			{
+				c_logger::get().log("[c_dataframe]: Column mismatch: " + name + "\n", LOG_CLR_RED);
+				return false;
+			}
+		}
+
+		for (auto& [name, col] : this->m_data)
+		{
+			const c_column& src = rows.m_data.find(name)->second;
+			const bool indexed = col.index() != nullptr;
+			const size_t size = col.size();
+
+			col.visit([&](auto& dst) {
+				using t = typename std::decay_t<decltype(dst)>::value_type;
+				src.visit([&](const auto& values) {
+					using s = typename std::decay_t<decltype(values)>::value_type;
+					if constexpr (std::is_same_v<t, s> || (std::is_same_v<t, double> && !std::is_same_v<s, std::string>))
+					{
+						rows._live_runs(0, rows.m_rows, [&](size_t p, size_t k) { dst.insert(dst.end(), values.begin() + p, values.begin() + p + k); });
+					}
+					});
+				});
+
+			if (!indexed) { continue; }
+
+			auto& index = col.index_ptr();
+			if (index.use_count() > 1) { index = std::make_shared<c_range_index>(*index); }
+			_visit_numeric(col, size, col.size() - size, [&](const auto* p, size_t k) { index->append(p, k); });
+			index->set_version(col.version());
+		}
+
+		this->m_rows += rows.m_rows;
+		return true;
+	}
+
+	bool dropna()
+	{
+		return this->_drop_rows_where([](const auto& v) -> bool {
+
+			using t = std::decay_t<decltype(v)>;
+
+			if constexpr (std::is_same_v<t, double>) { return std::isnan(v); }
+			else if constexpr (std::is_same_v<t, std::string>)
+			{
+				if (v.size() != 3) { return false; }
+				auto tl = [](unsigned char c) { return static_cast<char>(std::tolower(c)); };
+				return tl(v[0]) == 'n' && tl(v[1]) == 'a' && tl(v[2]) == 'n';
+			}
+			else { return false; }
+			});
+	}
+
+	bool dropinf()
+	{
+		return this->_drop_rows_where([](const auto& v) -> bool {
+
+			using t = std::decay_t<decltype(v)>;
+
+			if constexpr (std::is_same_v<t, double>) { return std::isinf(v); }
+			else if constexpr (std::is_same_v<t, std::string>)
+			{
+				if (v.size() < 3 || v.size() > 4) { return false; }
+				auto tl = [](unsigned char c) { return static_cast<char>(std::tolower(c)); };
+				size_t start = 0;
+				if (v[0] == '+' || v[0] == '-') { start = 1; }
+				if (v.size() - start != 3) { return false; }
+				return tl(v[start]) == 'i' && tl(v[start + 1]) == 'n' && tl(v[start + 2]) == 'f';
+			}
+			else { return false; }
+			});
+	}
+
+	bool dropemp()
+	{
+		return this->_drop_rows_where([](const auto& v) -> bool {
+
+			using t = std::decay_t<decltype(v)>;
+
+			if constexpr (std::is_same_v<t, std::string>) { return _is_blank(v); }
+			else { return false; }
+			});
+	}
+
+	c_column& at(const std::string& name)
+	{
+		this->compact();
+
+		auto it = this->m_data.find(name);
+		if (it != this->m_data.end())
+		{
+			it->second.touch();
+			return it->second;
+		}
+
+		auto [ins, ok] = this->m_data.emplace(name, c_column(e_dtype::str, this->m_rows));
+		return ins->second;
+	}
+
+	template<typename t>
+	std::vector<t> at(const std::string& name);
+
+	template<typename t>
+	std::vector<std::vector<t>> at(const std::vector<std::string>& names);
+
+	bool from_csv(const std::string& csv_path, bool header = true)
+	{
+		s_csv_options options;
+		options.header = header;
+		return this->from_csv(csv_path, options);
+	}
+
+	bool from_csv(const std::string& csv_path, const s_csv_options& options)
+	{
+		if (csv_path.empty()) { return false; }
+
+		if (this->m_data.size() || this->m_rows)
+		{
+			c_logger::get().log("[c_dataframe]: Already initialized\n", LOG_CLR_RED);
+			return false;
+		}
+
+		c_mapped_file file(csv_path);
+		if (!file.is_open()) { return false; }
+
+		const char* begin = file.data();
+		const char* end = begin + file.size();
+		std::string scratch;
+
+		std::vector<std::string> names;
+		if (options.header && begin < end)
+		{
+			begin = _tokenize_csv(begin, end, scratch, [&](size_t, std::string_view sv) { names.emplace_back(sv); }, []() { return false; });
+		}
+
+		s_csv_plan plan;
+		if (!_plan_csv(names, options, plan)) { return false; }
+
+		/*
+		*	skiprows and nrows only move the bounds with the newline index, the skipped bytes are never tokenized
+		*/
+		if (options.skiprows)
+		{
+			size_t skipped = 0;
+			const char* from = _seek_csv_records(begin, end, options.skiprows, skipped);
+			begin = skipped == options.skiprows ? from : end;
+		}
+
+		if (options.nrows)
+		{
+			size_t kept = 0;
+			const char* to = _seek_csv_records(begin, end, options.nrows, kept);
+			if (kept == options.nrows) { end = to; }
+		}
+
+		std::vector<s_csv_chunk> chunks = _split_csv(begin, end);
+
+		/*
+		*	count records per chunk; infer types from the leading sample, or from every chunk when infer_rows is 0
+		*/
+		std::vector<s_dtype_inference> inference(names.size());
+		c_thread_pool::get().parallel_for(chunks.size(), [&](size_t c) {
+			s_csv_chunk& chunk = chunks[c];
+			if (options.infer_rows)
+			{
+				chunk.rows = _count_csv_records(chunk.begin, chunk.end);
+				return;
+			}
+
+			chunk.inference.resize(names.size());
+			_infer_csv_sample(chunk.begin, chunk.end, options, plan, chunk.inference);
+			chunk.rows = _count_csv_records(chunk.begin, chunk.end);
+			});
+
+		if (options.infer_rows) { _infer_csv_sample(begin, end, options, plan, inference); }
+		else
+		{
+			for (const auto& chunk : chunks)
+			{
+				if (chunk.inference.size() > inference.size()) { inference.resize(chunk.inference.size()); }
+				for (size_t i = 0; i < chunk.inference.size(); ++i) { inference[i].merge(chunk.inference[i]); }
+			}
+		}
+
+		for (size_t i = names.size(); i < inference.size(); ++i) { names.push_back("col_" + std::to_string(i)); }
+
+		if (inference.empty()) { return true; }
+		if (!_check_csv_plan(names, plan)) { return false; }
+
+		_filter_csv_chunks(chunks, plan);
+
+		size_t records = 0;
+		for (const auto& chunk : chunks) { records += chunk.rows; }
+
+		if (!records) { return true; }
+
+		std::vector<c_column> columns(names.size());
+		std::vector<uint8_t> forced(names.size(), 0);
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			if (!plan.is_selected(i)) { continue; }
+
+			auto it = options.schema.find(names[i]);
+			forced[i] = it != options.schema.end();
+			columns[i] = c_column(forced[i] ? it->second : inference[i].type(), records);
+		}
+
+		if (!_parse_csv_chunks(chunks, columns, names, forced, plan)) { return false; }
+
+		for (size_t i = 0; i < columns.size(); ++i)
+		{
+			if (!plan.is_selected(i)) { continue; }
+
+			if (!this->_append_column(names[i], std::move(columns[i])))
+			{
+				this->reset();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	*	writes the frame in the binary columnar format described at _binary_magic
+	*/
+	bool save(const std::string& path) const
+	{
+		if (path.empty() || this->m_data.empty() || !this->m_rows) { return false; }
+		if (!this->_dense()) { return this->_rows(0, this->m_rows).save(path); }
+
+		std::ofstream file(path, std::ios::out | std::ios::binary);
+		if (!file.is_open()) { return false; }
+
+		uint64_t offset = sizeof(_binary_magic) + sizeof(uint32_t) + 2 * sizeof(uint64_t);
+		for (const auto& [name, col] : this->m_data) { offset += sizeof(uint8_t) + sizeof(uint32_t) + name.size() + 2 * sizeof(uint64_t); }
+
+		file.write(_binary_magic, sizeof(_binary_magic));
+		_write_pod(file, uint32_t(1));
+		_write_pod(file, uint64_t(this->m_rows));
+		_write_pod(file, uint64_t(this->m_data.size()));
+
+		std::vector<uint64_t> offsets;
+		for (const auto& [name, col] : this->m_data)
+		{
+			offset = (offset + _binary_align - 1) / _binary_align * _binary_align;
+			const uint64_t bytes = _binary_bytes(col);
+			offsets.push_back(offset);
+
+			_write_pod(file, static_cast<uint8_t>(col.type()));
+			_write_pod(file, static_cast<uint32_t>(name.size()));
+			file.write(name.data(), static_cast<std::streamsize>(name.size()));
+			_write_pod(file, offset);
+			_write_pod(file, bytes);
+
+			offset += bytes;
+		}
+
+		const char zeros[_binary_align] = {};
+		size_t i = 0;
+		for (const auto& [name, col] : this->m_data)
+		{
+			const uint64_t pos = static_cast<uint64_t>(file.tellp());
+			file.write(zeros, static_cast<std::streamsize>(offsets[i++] - pos));
+
+			col.visit([&](const auto& v) {
+				using t = typename std::decay_t<decltype(v)>::value_type;
+				if constexpr (std::is_same_v<t, std::string>)
+				{
+					uint64_t end = 0;
+					_write_pod(file, end);
+					for (const auto& x : v) { _write_pod(file, end += x.size()); }
+					for (const auto& x : v) { file.write(x.data(), static_cast<std::streamsize>(x.size())); }
+				}
+				else { file.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(t))); }
+				});
+		}
+
+		return file.good();
+	}
+
+	/*
+	*	loads a file written by save(). with mapped set the file stays mapped and numeric columns reference it directly, so
+	*	nothing is parsed or copied until a column is modified; string columns are always copied
+	*/
+	bool load(const std::string& path, bool mapped = true)
+	{
+		if (path.empty()) { return false; }
+
+		if (this->m_data.size() || this->m_rows)
+		{
+			c_logger::get().log("[c_dataframe]: Already initialized\n", LOG_CLR_RED);
+			return false;
+		}
+
+		auto file = std::make_shared<c_mapped_file>(path);
+		if (!file->is_open()) { return false; }
+
+		const char* data = file->data();
+		const size_t size = file->size();
+		size_t pos = 0;
+
+		auto invalid = [&]() {
+			c_logger::get().log("[c_dataframe]: Invalid binary file: " + path + "\n", LOG_CLR_RED);
+			this->reset();
+			return false;
+			};
+
+		char magic[sizeof(_binary_magic)] = {};
+		uint32_t order = 0;
+		uint64_t rows = 0, columns = 0;
+		if (!_read_pod(data, size, pos, magic) || std::memcmp(magic, _binary_magic, sizeof(magic)) != 0) { return invalid(); }
+		if (!_read_pod(data, size, pos, order) || order != 1) { return invalid(); }
+		if (!_read_pod(data, size, pos, rows) || !_read_pod(data, size, pos, columns) || !rows) { return invalid(); }
+
+		for (uint64_t c = 0; c < columns; ++c)
+		{
+			uint8_t type = 0;
+			uint32_t length = 0;
+			uint64_t offset = 0, bytes = 0;
+
+			if (!_read_pod(data, size, pos, type) || type > static_cast<uint8_t>(e_dtype::str)) { return invalid(); }
+			if (!_read_pod(data, size, pos, length) || size - pos < length) { return invalid(); }
+
+			std::string name(data + pos, length);
+			pos += length;
+
+			if (!_read_pod(data, size, pos, offset) || !_read_pod(data, size, pos, bytes)) { return invalid(); }
+			if (offset > size || bytes > size - offset) { return invalid(); }
+
+			c_column col;
+			if (!_read_binary_column(file, static_cast<e_dtype>(type), rows, offset, bytes, mapped, col)) { return invalid(); }
+			if (!this->_append_column(name, std::move(col)))
+			{
+				this->reset();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	*	reads an arrow ipc file (feather v2) or stream. int, float, bool, utf8 and binary fields are supported, uncompressed or
+	*	lz4 frame compressed. with mapped set, a single uncompressed batch of 64-bit ints or doubles without nulls is referenced
+	*	in place; everything else is copied. fields with nulls load as double (NaN) or as empty strings
+	*/
+	bool from_arrow(const std::string& path, bool mapped = true)
+	{
+		if (path.empty()) { return false; }
+
+		if (this->m_data.size() || this->m_rows)
+		{
+			c_logger::get().log("[c_dataframe]: Already initialized\n", LOG_CLR_RED);
+			return false;
+		}
+
+		auto file = std::make_shared<c_mapped_file>(path);
+		if (!file->is_open()) { return false; }
+
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(file->data());
+		size_t size = file->size();
+		size_t pos = 0;
+
+		auto invalid = [&]() {
+			c_logger::get().log("[c_dataframe]: Invalid arrow file: " + path + "\n", LOG_CLR_RED);
+			this->reset();
+			return false;
+			};
+
+		auto unsupported = [&](const std::string& what) {
+			c_logger::get().log("[c_dataframe]: Unsupported arrow " + what + "\n", LOG_CLR_RED);
+			this->reset();
+			return false;
+			};
+
+		/*
+		*	the file format wraps the stream in "ARROW1" magics and a footer, which is redundant with the stream messages
+		*/
+		if (size >= 8 && std::memcmp(data, "ARROW1", 6) == 0)
+		{
+			int32_t footer = 0;
+			if (size < 18 || std::memcmp(data + size - 6, "ARROW1", 6) != 0) { return invalid(); }
+			if (!n_flatbuffers::read(data, size, size - 10, footer) || footer < 0 || static_cast<size_t>(footer) > size - 18) { return invalid(); }
+
+			pos = 8;
+			size -= 10 + static_cast<size_t>(footer);
+		}
+
+		std::vector<s_arrow_field> fields;
+		std::vector<s_arrow_batch> batches;
+		bool schema = false;
+
+		while (size - pos >= 4)
+		{
+			uint32_t length = 0;
+			n_flatbuffers::read(data, size, pos, length);
+			pos += 4;
+
+			if (length == 0xFFFFFFFF)
+			{
+				if (!n_flatbuffers::read(data, size, pos, length)) { return invalid(); }
+				pos += 4;
+			}
+			if (!length) { break; }
+			if (length > size - pos) { return invalid(); }
+
+			const n_flatbuffers::s_table message = n_flatbuffers::root(data + pos, length);
+			const n_flatbuffers::s_table header = message.table(2);
+			const uint8_t kind = message.scalar<uint8_t>(1, 0);
+			const int64_t body_size = message.scalar<int64_t>(3, 0);
+			pos += length;
+
+			if (!header || body_size < 0 || static_cast<uint64_t>(body_size) > size - pos) { return invalid(); }
+
+			const uint8_t* body = data + pos;
+			pos += static_cast<size_t>(body_size);
+
+			if (kind == 1)
+			{
+				if (header.scalar<int16_t>(0, 0) != 0) { return unsupported("byte order"); }
+
+				const n_flatbuffers::s_vector list = header.vector(1);
+				for (size_t i = 0; i < list.count; ++i)
+				{
+					const n_flatbuffers::s_table field = list.table(i);
+					const n_flatbuffers::s_table type = field.table(3);
+					if (!field) { return invalid(); }
+
+					s_arrow_field f;
+					f.name = std::string(field.string(0));
+					f.type = field.scalar<uint8_t>(2, 0);
+					f.bits = type.scalar<int32_t>(0, 0);
+					f.is_signed = type.scalar<uint8_t>(1, 0) != 0;
+					f.precision = type.scalar<int16_t>(0, 0);
+
+					bool supported = !field.table(4);
+					switch (f.type)
+					{
+					case arrow_int: supported &= f.bits == 8 || f.bits == 16 || f.bits == 32 || f.bits == 64; break;
+					case arrow_float: supported &= f.precision == 1 || f.precision == 2; break;
+					case arrow_bool: case arrow_utf8: case arrow_binary: case arrow_large_utf8: case arrow_large_binary: break;
+					default: supported = false; break;
+					}
+					if (!supported) { return unsupported("type: " + f.name); }
+
+					fields.push_back(std::move(f));
+				}
+
+				schema = true;
+			}
+			else if (kind == 3)
+			{
+				s_arrow_batch batch;
+				batch.body = body;
+				batch.body_size = static_cast<size_t>(body_size);
+				batch.rows = header.scalar<int64_t>(0, 0);
+				batch.nodes = header.vector(1);
+				batch.buffers = header.vector(2);
+
+				const n_flatbuffers::s_table compression = header.table(3);
+				if (compression && compression.scalar<int8_t>(0, 0) != 0) { return unsupported("compression"); }
+				batch.compressed = static_cast<bool>(compression);
+
+				if (batch.rows < 0) { return invalid(); }
+				if (batch.rows) { batches.push_back(batch); }
+			}
+			else if (kind == 2) { return unsupported("dictionary batch"); }
+			else { return invalid(); }
+		}
+
+		if (!schema) { return invalid(); }
+
+		size_t rows = 0;
+		for (const auto& batch : batches) { rows += static_cast<size_t>(batch.rows); }
+		if (!rows || fields.empty()) { return true; }
+
+		size_t buffer = 0;
+		for (size_t k = 0; k < fields.size(); ++k)
+		{
+			const s_arrow_field& field = fields[k];
+
+			bool nulls = false;
+			for (const auto& batch : batches)
+			{
+				int64_t length = 0, count = 0;
+				if (!_arrow_node(batch, k, length, count)) { return invalid(); }
+				nulls |= count != 0;
+			}
+
+			e_dtype type = e_dtype::str;
+			if (field.type == arrow_float) { type = e_dtype::f64; }
+			else if (field.type == arrow_int) { type = nulls ? e_dtype::f64 : e_dtype::i64; }
+			else if (field.type == arrow_bool) { type = nulls ? e_dtype::f64 : e_dtype::boolean; }
+
+			c_column col;
+			bool viewed = false;
+
+			const bool wide = (field.type == arrow_float && field.precision == 2) || (field.type == arrow_int && field.bits == 64 && field.is_signed);
+			if (mapped && wide && !nulls && batches.size() == 1 && !batches[0].compressed)
+			{
+				std::vector<uint8_t> storage;
+				const uint8_t* values = nullptr;
+				size_t bytes = 0;
+				if (!_arrow_buffer(batches[0], buffer + 1, storage, values, bytes)) { return invalid(); }
+
+				if (bytes / 8 >= rows && reinterpret_cast<uintptr_t>(values) % 8 == 0)
+				{
+					col = c_column::view(type, values, rows, file);
+					viewed = true;
+				}
+			}
+
+			if (!viewed)
+			{
+				col = c_column(type, rows);
+
+				size_t at = 0;
+				for (const auto& batch : batches)
+				{
+					if (!_arrow_fill(batch, field, k, buffer, col, at)) { return invalid(); }
+					at += static_cast<size_t>(batch.rows);
+				}
+			}
+
+			buffer += _arrow_buffer_count(field.type);
+
+			if (!this->_append_column(field.name, std::move(col)))
+			{
+				this->reset();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	*	writes an uncompressed arrow ipc file (feather v2) holding one record batch: double, int64, bool and utf8 fields (large_utf8
+	*	past 2 GiB of text), no nulls
+	*/
+	bool to_arrow(const std::string& path) const
+	{
+		if (path.empty() || this->m_data.empty() || !this->m_rows) { return false; }
+		if (!this->_dense()) { return this->_rows(0, this->m_rows).to_arrow(path); }
+
+		std::ofstream file(path, std::ios::out | std::ios::binary);
+		if (!file.is_open()) { return false; }
+
+		std::vector<std::string> names;
+		std::vector<const c_column*> columns;
+		std::vector<uint8_t> types;
+		std::vector<int64_t> nodes;
+		std::vector<int64_t> buffers;
+
+		const int64_t rows = static_cast<int64_t>(this->m_rows);
+		int64_t body = 0;
+		auto add_buffer = [&](int64_t length) {
+			buffers.push_back(body);
+			buffers.push_back(length);
+			body += (length + 63) / 64 * 64;
+			};
+
+		for (const auto& [name, col] : this->m_data)
+		{
+			names.push_back(name);
+			columns.push_back(&col);
+			nodes.push_back(rows);
+			nodes.push_back(0);
+			add_buffer(0);
+
+			switch (col.type())
+			{
+			case e_dtype::f64: types.push_back(arrow_float); add_buffer(rows * 8); break;
+			case e_dtype::i64: types.push_back(arrow_int); add_buffer(rows * 8); break;
+			case e_dtype::boolean: types.push_back(arrow_bool); add_buffer((rows + 7) / 8); break;
+			case e_dtype::str:
+			{
+				int64_t chars = 0;
+				for (const auto& x : col.values<std::string>()) { chars += static_cast<int64_t>(x.size()); }
+
+				const bool large = chars > std::numeric_limits<int32_t>::max();
+				types.push_back(large ? arrow_large_utf8 : arrow_utf8);
+				add_buffer((rows + 1) * (large ? 8 : 4));
+				add_buffer(chars);
+				break;
+			}
+			}
+		}
+
+		file.write("ARROW1\0\0", 8);
+
+		{
+			n_flatbuffers::c_builder b;
+			b.add<int16_t>(0, 4);
+			b.add<uint8_t>(1, 1);
+			b.add_offset(2);
+			const size_t message = b.end_table();
+			const size_t header_slot = b.slot(2);
+			b.patch(header_slot, _arrow_schema(b, names, types));
+			_write_arrow_message(file, b.finish(message));
+		}
+
+		const int64_t batch_offset = static_cast<int64_t>(file.tellp());
+		int32_t batch_metadata = 0;
+		{
+			n_flatbuffers::c_builder b;
+			b.add<int16_t>(0, 4);
+			b.add<uint8_t>(1, 3);
+			b.add_offset(2);
+			b.add<int64_t>(3, body);
+			const size_t message = b.end_table();
+			const size_t header_slot = b.slot(2);
+
+			b.add<int64_t>(0, rows);
+			b.add_offset(1);
+			b.add_offset(2);
+			const size_t batch = b.end_table();
+			const size_t nodes_slot = b.slot(1), buffers_slot = b.slot(2);
+
+			b.patch(header_slot, batch);
+			b.patch(nodes_slot, b.add_structs(nodes.data(), nodes.size() / 2, 16));
+			b.patch(buffers_slot, b.add_structs(buffers.data(), buffers.size() / 2, 16));
+			batch_metadata = static_cast<int32_t>(_write_arrow_message(file, b.finish(message)));
+		}
+
+		const char zeros[64] = {};
+		int64_t written = 0;
+		size_t next = 0;
+		auto begin_buffer = [&]() {
+			const int64_t offset = buffers[2 * next];
+			file.write(zeros, static_cast<std::streamsize>(offset - written));
+			written = offset + buffers[2 * next + 1];
+			next++;
+			};
+
+		for (const c_column* col : columns)
+		{
+			begin_buffer();
+			begin_buffer();
+
+			col->visit([&](const auto& v) {
+				using t = typename std::decay_t<decltype(v)>::value_type;
+				if constexpr (std::is_same_v<t, std::string>)
+				{
+					const bool large = buffers[2 * next - 1] == (rows + 1) * 8;
+					int64_t end = 0;
+					auto put = [&](int64_t o) {
+						if (large) { _write_pod(file, o); }
+						else { _write_pod(file, static_cast<int32_t>(o)); }
+						};
+
+					put(end);
+					for (const auto& x : v) { put(end += static_cast<int64_t>(x.size())); }
+
+					begin_buffer();
+					for (const auto& x : v) { file.write(x.data(), static_cast<std::streamsize>(x.size())); }
+				}
+				else if constexpr (std::is_same_v<t, uint8_t>)
+				{
+					std::vector<uint8_t> bits((v.size() + 7) / 8, 0);
+					for (size_t i = 0; i < v.size(); ++i) { bits[i >> 3] |= static_cast<uint8_t>((v[i] ? 1 : 0) << (i & 7)); }
+					file.write(reinterpret_cast<const char*>(bits.data()), static_cast<std::streamsize>(bits.size()));
+				}
+				else { file.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(t))); }
+				});
+		}
+		file.write(zeros, static_cast<std::streamsize>(body - written));
+
+		_write_pod(file, uint32_t(0xFFFFFFFF));
+		_write_pod(file, uint32_t(0));
+
+		{
+			n_flatbuffers::c_builder b;
+			b.add<int16_t>(0, 4);
+			b.add_offset(1);
+			b.add_offset(2);
+			b.add_offset(3);
+			const size_t footer = b.end_table();
+			const size_t schema_slot = b.slot(1), dictionaries_slot = b.slot(2), batches_slot = b.slot(3);
+
+			uint8_t block[24] = {};
+			std::memcpy(block, &batch_offset, 8);
+			std::memcpy(block + 8, &batch_metadata, 4);
+			std::memcpy(block + 16, &body, 8);
+
+			b.patch(schema_slot, _arrow_schema(b, names, types));
+			b.patch(dictionaries_slot, b.add_offsets(0));
+			b.patch(batches_slot, b.add_structs(block, 1, 24));
+
+			const auto& bytes = b.finish(footer);
+			file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			_write_pod(file, static_cast<int32_t>(bytes.size()));
+		}
+
+		file.write("ARROW1", 6);
+		return file.good();
+	}
+
+	/*
+	*	reads a parquet file with a flat schema. only the column chunks of selected and predicate columns are read, and row
+	*	groups whose min/max statistics rule out a where predicate are skipped entirely. PLAIN, dictionary and RLE encoded
+	*	pages (v1 and v2), uncompressed, snappy or lz4 raw, are supported. nullable int and bool columns load as double (NaN),
+	*	nullable strings as empty strings
+	*/
+	bool from_parquet(const std::string& path, const s_parquet_options& options = {})
+	{
+		if (path.empty()) { return false; }
+
+		if (this->m_data.size() || this->m_rows)
+		{
+			c_logger::get().log("[c_dataframe]: Already initialized\n", LOG_CLR_RED);
+			return false;
+		}
+
+		c_mapped_file file(path);
+		if (!file.is_open()) { return false; }
+
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(file.data());
+		const size_t size = file.size();
+
+		auto invalid = [&]() {
+			c_logger::get().log("[c_dataframe]: Invalid parquet file: " + path + "\n", LOG_CLR_RED);
+			this->reset();
+			return false;
+			};
+
+		if (size < 12 || std::memcmp(data, "PAR1", 4) != 0 || std::memcmp(data + size - 4, "PAR1", 4) != 0) { return invalid(); }
+
+		uint32_t footer = 0;
+		std::memcpy(&footer, data + size - 8, sizeof(footer));
+		if (footer > size - 12) { return invalid(); }
+
+		std::vector<s_parquet_column> columns;
+		std::vector<s_parquet_group> groups;
+		if (!_read_parquet_footer(data + size - 8 - footer, footer, columns, groups)) { return invalid(); }
+
+		auto find = [&](const std::string& name) -> size_t {
+			for (size_t i = 0; i < columns.size(); ++i)
+			{
+				if (columns[i].name == name) { return i; }
+			}
+			c_logger::get().log("[c_dataframe]: No column name: " + name + "\n", LOG_CLR_RED);
+			return columns.size();
+			};
+
+		std::vector<uint8_t> selected(columns.size(), options.usecols.empty() ? 1 : 0);
+		for (const auto& name : options.usecols)
+		{
+			const size_t i = find(name);
+			if (i == columns.size()) { return false; }
+			selected[i] = 1;
+		}
+
+		std::vector<size_t> where;
+		for (const auto& predicate : options.where)
+		{
+			const size_t i = find(predicate.column);
+			if (i == columns.size()) { return false; }
+			where.push_back(i);
+		}
+
+		/*
+		*	decoded columns: the selected ones plus those only needed to evaluate predicates
+		*/
+		std::vector<size_t> needed;
+		for (size_t i = 0; i < columns.size(); ++i)
+		{
+			if (selected[i] || std::find(where.begin(), where.end(), i) != where.end()) { needed.push_back(i); }
+		}
+
+		std::vector<e_dtype> types(columns.size(), e_dtype::f64);
+		for (size_t i : needed)
+		{
+			bool nulls = false;
+			for (const auto& group : groups)
+			{
+				const int32_t codec = group.chunks[i].codec;
+				if (codec != 0 && codec != 1 && codec != 7)
+				{
+					c_logger::get().log("[c_dataframe]: Unsupported parquet compression: " + columns[i].name + "\n", LOG_CLR_RED);
+					return false;
+				}
+
+				nulls |= columns[i].optional && group.chunks[i].nulls != 0;
+			}
+
+			switch (columns[i].type)
+			{
+			case parquet_boolean: types[i] = nulls ? e_dtype::f64 : e_dtype::boolean; break;
+			case parquet_int32: case parquet_int64: types[i] = nulls ? e_dtype::f64 : e_dtype::i64; break;
+			case parquet_float: case parquet_double: types[i] = e_dtype::f64; break;
+			case parquet_byte_array: types[i] = e_dtype::str; break;
+			default:
+				c_logger::get().log("[c_dataframe]: Unsupported parquet type: " + columns[i].name + "\n", LOG_CLR_RED);
+				return false;
+			}
+		}
+
+		std::vector<size_t> kept;
+		size_t rows = 0;
+		for (size_t g = 0; g < groups.size(); ++g)
+		{
+			bool match = groups[g].rows > 0;
+			for (size_t p = 0; p < where.size() && match; ++p) { match = _parquet_may_match(columns[where[p]], groups[g].chunks[where[p]], options.where[p]); }
+			if (!match) { continue; }
+
+			groups[g].offset = rows;
+			rows += static_cast<size_t>(groups[g].rows);
+			kept.push_back(g);
+		}
+
+		if (!rows) { return true; }
+
+		std::vector<c_column> values(columns.size());
+		for (size_t i : needed) { values[i] = c_column(types[i], rows); }
+
+		std::atomic<bool> failed{ false };
+		c_thread_pool::get().parallel_for(kept.size() * needed.size(), [&](size_t task) {
+			const s_parquet_group& group = groups[kept[task / needed.size()]];
+			const size_t i = needed[task % needed.size()];
+			if (!failed && !_read_parquet_chunk(data, size, columns[i], group.chunks[i], static_cast<size_t>(group.rows), values[i], group.offset)) { failed = true; }
+			});
+
+		if (failed) { return invalid(); }
+		for (size_t i : needed) { values[i].touch(); }
+
+		/*
+		*	row groups only prune whole ranges, the predicates still decide each row
+		*/
+		if (!where.empty())
+		{
+			std::vector<uint8_t> keep(rows, 1);
+			size_t count = 0;
+			for (size_t r = 0; r < rows; ++r)
+			{
+				for (size_t p = 0; p < where.size() && keep[r]; ++p) { keep[r] = _test_value(values[where[p]], r, options.where[p]); }
+				count += keep[r];
+			}
+
+			if (!count) { return true; }
+			if (count != rows)
+			{
+				c_thread_pool::get().parallel_for(needed.size(), [&](size_t k) {
+					if (selected[needed[k]]) { _compact(values[needed[k]], keep, count); }
+					});
+			}
+		}
+
+		for (size_t i = 0; i < columns.size(); ++i)
+		{
+			if (!selected[i]) { continue; }
+
+			if (!this->_append_column(columns[i].name, std::move(values[i])))
+			{
+				this->reset();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	*	writes a parquet file with PLAIN encoded data pages of up to _parquet_page_bytes, row groups of row_group_rows rows and
+	*	min/max statistics so readers can skip row groups. row groups are encoded and compressed in parallel
+	*/
+	bool to_parquet(const std::string& path, e_codec codec = e_codec::snappy, size_t row_group_rows = 1 << 20) const
+	{
+		if (path.empty() || this->m_data.empty() || !this->m_rows || !row_group_rows) { return false; }
+		if (!this->_dense()) { return this->_rows(0, this->m_rows).to_parquet(path, codec, row_group_rows); }
+
+		std::ofstream file(path, std::ios::out | std::ios::binary);
+		if (!file.is_open()) { return false; }
+
+		std::vector<std::string> names;
+		std::vector<const c_column*> columns;
+		std::vector<int32_t> types;
+		for (const auto& [name, col] : this->m_data)
+		{
+			names.push_back(name);
+			columns.push_back(&col);
+
+			switch (col.type())
+			{
+			case e_dtype::f64: types.push_back(parquet_double); break;
+			case e_dtype::i64: types.push_back(parquet_int64); break;
+			case e_dtype::boolean: types.push_back(parquet_boolean); break;
+			case e_dtype::str: types.push_back(parquet_byte_array); break;
+			}
+		}
+
+		struct s_page
+		{
+			std::vector<uint8_t> header;
+			std::vector<uint8_t> body;
+			size_t raw = 0;
+		};
+
+		struct s_chunk
+		{
+			int64_t offset = 0;
+			int64_t size = 0;
+			int64_t raw = 0;
+			bool stats = false;
+			std::string min;
+			std::string max;
+		};
+
+		struct s_group
+		{
+			size_t rows = 0;
+			std::vector<s_chunk> chunks;
+		};
+
+		std::vector<s_group> groups;
+		std::vector<std::vector<s_page>> pages(columns.size());
+
+		file.write("PAR1", 4);
+		int64_t written = 4;
+
+		for (size_t from = 0; from < this->m_rows; from += row_group_rows)
+		{
+			const size_t to = std::min(this->m_rows, from + row_group_rows);
+
+			s_group group;
+			group.rows = to - from;
+			group.chunks.resize(columns.size());
+
+			std::atomic<bool> failed{ false };
+			c_thread_pool::get().parallel_for(columns.size(), [&](size_t c) {
+				s_chunk& chunk = group.chunks[c];
+				pages[c].clear();
+
+				for (size_t a = from; a < to && !failed;)
+				{
+					const size_t b = _parquet_page_end(*columns[c], a, to);
+
+					s_page page;
+					std::vector<uint8_t> body;
+					std::string min, max;
+					if (_plain_parquet_page(*columns[c], a, b, body, min, max))
+					{
+						if (!chunk.stats)
+						{
+							chunk.min = std::move(min);
+							chunk.max = std::move(max);
+							chunk.stats = true;
+						}
+						else { _merge_parquet_stats(*columns[c], min, max, chunk.min, chunk.max); }
+					}
+					page.raw = body.size();
+
+					if (codec == e_codec::snappy) { n_snappy::encode(body.data(), body.size(), page.body); }
+					else { page.body = std::move(body); }
+
+					/*
+					*	page sizes are i32, a single value too large for one page cannot be written
+					*/
+					if (page.raw > static_cast<size_t>(std::numeric_limits<int32_t>::max()) || page.body.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+					{
+						failed = true;
+						return;
+					}
+
+					/*
+					*	PageHeader: DATA_PAGE, sizes, data_page_header {num_values, PLAIN, RLE levels}
+					*/
+					n_thrift::c_writer w;
+					w.i32(1, 0);
+					w.i32(2, static_cast<int32_t>(page.raw));
+					w.i32(3, static_cast<int32_t>(page.body.size()));
+					w.begin(5);
+					w.i32(1, static_cast<int32_t>(b - a));
+					w.i32(2, 0);
+					w.i32(3, 3);
+					w.i32(4, 3);
+					w.end();
+					w.end();
+					page.header = std::move(w.buffer());
+
+					chunk.size += static_cast<int64_t>(page.header.size() + page.body.size());
+					chunk.raw += static_cast<int64_t>(page.header.size() + page.raw);
+					pages[c].push_back(std::move(page));
+					a = b;
+				}
+				});
+
+			if (failed)
+			{
+				c_logger::get().log("[c_dataframe]: Parquet page too large: " + path + "\n", LOG_CLR_RED);
+				return false;
+			}
+
+			for (size_t c = 0; c < columns.size(); ++c)
+			{
+				group.chunks[c].offset = written;
+				for (const s_page& page : pages[c])
+				{
+					file.write(reinterpret_cast<const char*>(page.header.data()), static_cast<std::streamsize>(page.header.size()));
+					file.write(reinterpret_cast<const char*>(page.body.data()), static_cast<std::streamsize>(page.body.size()));
+				}
+				written += group.chunks[c].size;
+			}
+
+			groups.push_back(std::move(group));
+		}
+
+		/*
+		*	FileMetaData: 1 version, 2 schema, 3 num_rows, 4 row_groups, 6 created_by, 7 column_orders
+		*/
+		n_thrift::c_writer w;
+		w.i32(1, 1);
+		w.list(2, n_thrift::structure, columns.size() + 1);
+		w.begin();
+		w.binary(4, "schema");
+		w.i32(5, static_cast<int32_t>(columns.size()));
+		w.end();
+		for (size_t c = 0; c < columns.size(); ++c)
+		{
+			w.begin();
+			w.i32(1, types[c]);
+			w.i32(3, 0);
+			w.binary(4, names[c]);
+			if (types[c] == parquet_byte_array) { w.i32(6, 0); }
+			w.end();
+		}
+
+		w.i64(3, static_cast<int64_t>(this->m_rows));
+		w.list(4, n_thrift::structure, groups.size());
+		for (const auto& group : groups)
+		{
+			int64_t group_bytes = 0;
+			for (const auto& chunk : group.chunks) { group_bytes += chunk.raw; }
+
+			w.begin();
+			w.list(1, n_thrift::structure, columns.size());
+			for (size_t c = 0; c < columns.size(); ++c)
+			{
+				const s_chunk& chunk = group.chunks[c];
+
+				/*
+				*	ColumnChunk: 2 file_offset, 3 meta_data {type, encodings, path, codec, values, sizes, data_page_offset, statistics}
+				*/
+				w.begin();
+				w.i64(2, chunk.offset);
+				w.begin(3);
+				w.i32(1, types[c]);
+				w.list(2, n_thrift::i32, 2);
+				w.value(int64_t(0));
+				w.value(int64_t(3));
+				w.list(3, n_thrift::binary, 1);
+				w.value(std::string_view(names[c]));
+				w.i32(4, codec == e_codec::snappy ? 1 : 0);
+				w.i64(5, static_cast<int64_t>(group.rows));
+				w.i64(6, chunk.raw);
+				w.i64(7, chunk.size);
+				w.i64(9, chunk.offset);
+				w.begin(12);
+				w.i64(3, 0);
+				if (chunk.stats)
+				{
+					w.binary(5, chunk.max);
+					w.binary(6, chunk.min);
+				}
+				w.end();
+				w.end();
+				w.end();
+			}
+			w.i64(2, group_bytes);
+			w.i64(3, static_cast<int64_t>(group.rows));
+			w.end();
+		}
+
+		w.binary(6, "dataframe");
+
+		/*
+		*	column_orders: without them readers treat min_value/max_value as undefined
+		*/
+		w.list(7, n_thrift::structure, columns.size());
+		for (size_t c = 0; c < columns.size(); ++c)
+		{
+			w.begin();
+			w.begin(1);
+			w.end();
+			w.end();
+		}
+		w.end();
+
+		const auto& metadata = w.buffer();
+		file.write(reinterpret_cast<const char*>(metadata.data()), static_cast<std::streamsize>(metadata.size()));
+		_write_pod(file, static_cast<uint32_t>(metadata.size()));
+		file.write("PAR1", 4);
+		return file.good();
+	}
+
+	/*
+	*	row ranges are formatted into reusable buffers, in parallel unless disabled, and written in order in large blocks
+	*/
+	bool to_csv(const std::string& csv_path, bool header = true, bool parallel = true) const
+	{
+		if (csv_path.empty() || this->m_data.empty() || !this->m_rows) { return false; }
+		if (!this->_dense()) { return this->_rows(0, this->m_rows).to_csv(csv_path, header, parallel); }
+
+		std::ofstream file(csv_path, std::ios::out | std::ios::binary);
+		if (!file.is_open()) { return false; }
+
+		std::vector<const c_column*> columns;
+		columns.reserve(this->m_data.size());
+
+		std::string names;
+		for (const auto& [key, value] : this->m_data)
+		{
+			if (!columns.empty()) { names.push_back(','); }
+			_write_csv_string(key, names);
+			columns.push_back(&value);
+		}
+
+		if (header) { file.write(names.data(), static_cast<std::streamsize>(names.size())); }
+
+		const size_t blocks = (this->m_rows + _csv_write_rows - 1) / _csv_write_rows;
+		std::vector<std::string> buffers(std::min(blocks, parallel ? c_thread_pool::get().size() * 2 : size_t(1)));
+
+		for (size_t first = 0; first < blocks; first += buffers.size())
+		{
+			const size_t count = std::min(buffers.size(), blocks - first);
+
+			auto format = [&](size_t b) {
+				std::string& out = buffers[b];
+				out.clear();
+
+				const size_t from = (first + b) * _csv_write_rows;
+				const size_t to = std::min(this->m_rows, from + _csv_write_rows);
+				for (size_t row = from; row < to; ++row)
+				{
+					if (header) { out.push_back('\n'); }
+					for (size_t j = 0; j < columns.size(); ++j)
+					{
+						if (j) { out.push_back(','); }
+						_write_csv_field(*columns[j], row, out);
+					}
+					if (!header) { out.push_back('\n'); }
+				}
+				};
+
+			if (parallel) { c_thread_pool::get().parallel_for(count, format); }
+			else { for (size_t b = 0; b < count; ++b) { format(b); } }
+
+			for (size_t b = 0; b < count; ++b) { file.write(buffers[b].data(), static_cast<std::streamsize>(buffers[b].size())); }
+		}
+
+		return file.good();
+	}
+
+	std::pair<size_t, size_t> shape() const
+	{
+		return { this->m_rows, this->m_data.size() };
+	}
+
+	double sum(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		if (const c_range_index* index = this->_range_index(*col)) { return this->_indexed(*index, *col, e_stat::sum, from, length); }
+
+		return _cached(*col, e_stat::sum, from, length, [&]() { return this->_sum(*col, from, length); });
+	}
+
+	double prod(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		return _cached(*col, e_stat::prod, from, length, [&]() {
+			double prod = 1.0;
+			this->_visit_live(*col, from, length, [&](const auto* p, size_t k) { prod *= _span_prod(p, k); });
+			return prod;
+			});
+	}
+
+	double mean(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		if (const c_range_index* index = this->_range_index(*col)) { return this->_indexed(*index, *col, e_stat::sum, from, length) / static_cast<double>(length); }
+
+		return _cached(*col, e_stat::sum, from, length, [&]() { return this->_sum(*col, from, length); }) / static_cast<double>(length);
+	}
+
+	double var(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		return this->_var(*col, from, length);
+	}
+
+	double std(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		double v = this->var(name, from, length);
+		return std::isnan(v) ? v : std::sqrt(v);
+	}
+
+	double min(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		if (const c_range_index* index = this->_range_index(*col)) { return this->_indexed(*index, *col, e_stat::min, from, length); }
+
+		return _cached(*col, e_stat::min, from, length, [&]() {
+			double min = std::numeric_limits<double>::infinity();
+			this->_visit_live(*col, from, length, [&](const auto* p, size_t k) { min = _span_min(p, k, min); });
+			return min;
+			});
+	}
+
+	double max(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		if (const c_range_index* index = this->_range_index(*col)) { return this->_indexed(*index, *col, e_stat::max, from, length); }
+
+		return _cached(*col, e_stat::max, from, length, [&]() {
+			double max = -std::numeric_limits<double>::infinity();
+			this->_visit_live(*col, from, length, [&](const auto* p, size_t k) { max = _span_max(p, k, max); });
+			return max;
+			});
+	}
+
+	/*
+	*	the statistic of each named column, in order (NaN for a missing column). the columns are reduced over one shared task
+	*	list of row blocks, each block read once, and every value equals the single-column call
+	*/
+	std::vector<double> sum(const std::vector<std::string>& names, size_t from = 0, size_t length = 0) const
+	{
+		return this->_batch(names, from, length, e_stat::sum);
+	}
+
+	std::vector<double> mean(const std::vector<std::string>& names, size_t from = 0, size_t length = 0) const
+	{
+		std::vector<double> out = this->_batch(names, from, length, e_stat::sum);
+		for (double& v : out) { v /= static_cast<double>(length); }
+		return out;
+	}
+
+	std::vector<double> var(const std::vector<std::string>& names, size_t from = 0, size_t length = 0) const
+	{
+		return this->_batch(names, from, length, e_stat::var);
+	}
+
+	std::vector<double> std(const std::vector<std::string>& names, size_t from = 0, size_t length = 0) const
+	{
+		std::vector<double> out = this->_batch(names, from, length, e_stat::var);
+		for (double& v : out) { v = std::isnan(v) ? v : std::sqrt(v); }
+		return out;
+	}
+
+	std::vector<double> min(const std::vector<std::string>& names, size_t from = 0, size_t length = 0) const
+	{
+		return this->_batch(names, from, length, e_stat::min);
+	}
+
+	std::vector<double> max(const std::vector<std::string>& names, size_t from = 0, size_t length = 0) const
+	{
+		return this->_batch(names, from, length, e_stat::max);
+	}
+
+	double cov(const std::string& name1, const std::string& name2, size_t from = 0, size_t length = 0) const
+	{
+		if (name1.empty() || name2.empty())
+		{
+			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+
+		const c_column* col1 = this->_find_range(name1, from, length);
+		if (!col1) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		const c_column* col2 = this->_find_range(name2, from, length);
+		if (!col2) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		const n_math::s_comoments m = this->_reduce_blocks<n_math::s_comoments>(from, length,
+			[&](n_math::s_comoments& part, size_t f, size_t l) {
+				this->_visit_live(*col1, *col2, f, l, [&](const auto* p1, const auto* p2, size_t k) { part.add(p1, p2, k); });
+			},
+			[](n_math::s_comoments& acc, const n_math::s_comoments& part) { acc.merge(part); });
+
+		// pairs are centered on sum / length of each column rather than on their own means
+		const double mean1 = m.sum1 / static_cast<double>(length);
+		const double mean2 = m.sum2 / static_cast<double>(length);
+		const double covariance = m.c + static_cast<double>(m.n) * (m.mean1 - mean1) * (m.mean2 - mean2);
+
+		return covariance / (static_cast<double>(length) - 1);
+	}
+
+	double corr(const std::string& name1, const std::string& name2, size_t from = 0, size_t length = 0) const
+	{
+		if (name1.empty() || name2.empty())
+		{
+			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+
+		double covariance = this->cov(name1, name2, from, length);
+		if (std::isnan(covariance)) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		double std1 = this->std(name1, from, length);
+		if (std::isnan(std1)) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		double std2 = this->std(name2, from, length);
+		if (std::isnan(std2)) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		return covariance / (std1 * std2);
+	}
+
+	/*
+	*	gathers the live values of the column once (NaN kept); the returned c_rolling does not reference the frame
+	*/
+	c_rolling rolling(const std::string& name, size_t window, size_t min_periods = 0) const
+	{
+		size_t from = 0;
+		size_t length = 0;
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col || !window)
+		{
+			c_logger::get().log("[c_dataframe]: Invalid rolling column or window: " + name + "\n", LOG_CLR_RED);
+			return c_rolling({}, 0, 0);
+		}
+
+		std::vector<double> values;
+		values.reserve(length);
+		this->_visit_live(*col, from, length, [&](const auto* p, size_t k) {
+			for (size_t i = 0; i < k; ++i) { values.push_back(static_cast<double>(p[i])); }
+			});
+
+		return c_rolling(std::move(values), window, min_periods);
+	}
+
+	/*
+	*	cov / corr of every pair of the named columns (every numeric column when names is empty) as a frame with one row per
+	*	column, labeled in its "column" column; element (a, b) equals cov(a, b) / corr(a, b) up to rounding
+	*/
+	c_dataframe cov_matrix(std::vector<std::string> names = {}, size_t from = 0, size_t length = 0) const
+	{
+		const std::vector<const c_column*> cols = this->_matrix_columns(names, from, length);
+		if (cols.empty()) { return c_dataframe(); }
+
+		std::vector<double> m = this->_comoment_matrix(cols, from, length);
+		for (double& v : m) { v /= (static_cast<double>(length) - 1); }
+
+		return _matrix_frame(names, m);
+	}
+
+	c_dataframe corr_matrix(std::vector<std::string> names = {}, size_t from = 0, size_t length = 0) const
+	{
+		const std::vector<const c_column*> cols = this->_matrix_columns(names, from, length);
+		if (cols.empty()) { return c_dataframe(); }
+
+		const size_t n = cols.size();
+		std::vector<double> stds(n);
+		for (size_t c = 0; c < n; ++c) { stds[c] = std::sqrt(this->_var(*cols[c], from, length)); }
+
+		std::vector<double> m = this->_comoment_matrix(cols, from, length);
+		for (size_t i = 0; i < n; ++i)
+		{
+			for (size_t j = 0; j < n; ++j) { m[i * n + j] = m[i * n + j] / (static_cast<double>(length) - 1) / (stds[i] * stds[j]); }
+		}
+
+		return _matrix_frame(names, m);
+	}
+
+	double skew(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		return _cached(*col, e_stat::skew, from, length, [&]() { return this->_describe(*col, from, length).skew; });
+	}
+
+	double kurt(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		return _cached(*col, e_stat::kurt, from, length, [&]() { return this->_describe(*col, from, length).kurt; });
+	}
+
+	/*
+	*	exact quantile q in [0, 1] of the non-NaN values, linearly interpolated between ranks (pandas' default); O(n) selection
+	*/
+	double quantile(const std::string& name, double q, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return std::numeric_limits<double>::quiet_NaN(); }
+
+		return this->_quantiles(*col, from, length, { q })[0];
+	}
+
+	std::vector<double> quantile(const std::string& name, const std::vector<double>& qs, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return std::vector<double>(qs.size(), std::numeric_limits<double>::quiet_NaN()); }
+
+		return this->_quantiles(*col, from, length, qs);
+	}
+
+	double median(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		return this->quantile(name, 0.5, from, length);
+	}
+
+	/*
+	*	approximate quantiles: a c_tdigest of the column built from parallel blocks merged in block order; keep adding
+	*	values or merge other digests into it to follow a growing column
+	*/
+	c_tdigest sketch(const std::string& name, double compression = 100.0, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return c_tdigest(compression); }
+
+		return this->_reduce_blocks<c_tdigest>(from, length,
+			[&](c_tdigest& part, size_t f, size_t l) { this->_visit_live(*col, f, l, [&](const auto* p, size_t k) { part.add(p, k); }); },
+			[](c_tdigest& acc, const c_tdigest& part) { acc.merge(part); },
+			c_tdigest(compression));
+	}
+
+	s_stats describe(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return {}; }
+
+		return this->_describe(*col, from, length);
+	}
+
+	/*
+	*	one row per statistic (named in the "stat" column) and one double column per numeric column, described in parallel
+	*/
+	c_dataframe describe() const
+	{
+		std::vector<std::pair<const std::string*, const c_column*>> cols;
+		for (const auto& [name, col] : this->m_data)
+		{
+			if (col.is_numeric() && name != "stat") { cols.emplace_back(&name, &col); }
+		}
+
+		if (cols.empty() || !this->m_rows)
+		{
+			c_logger::get().log("[c_dataframe]: No data\n", LOG_CLR_RED);
+			return c_dataframe();
+		}
+
+		std::vector<s_stats> stats(cols.size());
+		c_thread_pool::get().parallel_for(cols.size(), [&](size_t c) { stats[c] = this->_describe(*cols[c].second, 0, this->m_rows); });
+
+		c_dataframe df;
+		df.add_column("stat", std::vector<std::string>{ "count", "sum", "mean", "var", "std", "min", "max", "skew", "kurt" });
+		for (size_t c = 0; c < cols.size(); ++c)
+		{
+			const s_stats& s = stats[c];
+			df.add_column(*cols[c].first, std::vector<double>{ static_cast<double>(s.count), s.sum, s.mean, s.var, s.std, s.min, s.max, s.skew, s.kurt });
+		}
+
+		return df;
+	}
+
+	/*
+	*	transform of the non-NaN values of a column into out, reusing its capacity (no allocation once it is large enough):
+	*	diff, pct_change and log_change start with NaN, cumsum and cumprod hold the running total. false and an empty out
+	*	when the column or range is invalid
+	*/
+	bool transform(const std::string& name, e_transform op, std::vector<double>& out, size_t from = 0, size_t length = 0) const
+	{
+		out.clear();
+
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return false; }
+
+		if (op == e_transform::cumsum || op == e_transform::cumprod)
+		{
+			const std::vector<size_t> offsets = this->_scan_offsets(*col, from, length, false);
+			out.resize(offsets.back());
+			this->_cumulative(*col, from, length, op, false, out.data(), offsets);
+			return true;
+		}
+
+		out.reserve(length);
+		this->_transform(*col, from, length, op, false, [&out](double y) { out.push_back(y); });
+		if (out.empty() && op != e_transform::cumsum && op != e_transform::cumprod) { out.push_back(std::numeric_limits<double>::quiet_NaN()); }
+
+		return true;
+	}
+
+	/*
+	*	writes the transform of live rows [from, from + length) of name straight into the same rows of the double column
+	*	target (created NaN-filled when missing, and may be name itself); rows where name is NaN become NaN
+	*/
+	bool transform(const std::string& name, e_transform op, const std::string& target, size_t from = 0, size_t length = 0)
+	{
+		this->compact();
+
+		if (target.empty())
+		{
+			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
+			return false;
+		}
+
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return false; }
+
+		auto it = this->m_data.find(target);
+		if (it == this->m_data.end())
+		{
+			if (!this->_append_column(target, _to_column(std::vector<double>(this->m_rows, std::numeric_limits<double>::quiet_NaN())))) { return false; }
+			it = this->m_data.find(target);
+		}
+		else if (it->second.type() != e_dtype::f64)
+		{
+			c_logger::get().log("[c_dataframe]: Column is not double: " + target + "\n", LOG_CLR_RED);
+			return false;
+		}
+
+		double* out = it->second.values<double>().data() + from;
+		if (op == e_transform::cumsum || op == e_transform::cumprod) { this->_cumulative(*col, from, length, op, true, out, this->_scan_offsets(*col, from, length, true)); }
+		else { this->_transform(*col, from, length, op, true, [&out](double y) { *out++ = y; }); }
+
+		return true;
+	}
+
+	/*
+	*	inclusive scan of the non-NaN values with an associative op(a, b) (std::plus<double>(), a running max, ...), in
+	*	parallel blocks like cumsum / cumprod, so op is called from several threads; out is refilled in place
+	*/
+	template<class op_t>
+	bool scan(const std::string& name, op_t&& op, std::vector<double>& out, size_t from = 0, size_t length = 0) const
+	{
+		out.clear();
+
+		const c_column* col = this->_find_range(name, from, length);
+		if (!col) { return false; }
+
+		const std::vector<size_t> offsets = this->_scan_offsets(*col, from, length, false);
+		out.resize(offsets.back());
+		this->_scan(*col, from, length, offsets, out.data(), op, [&](const auto* p, size_t k, double* o, double& total, bool& seen, bool) {
+			return _scan_span(p, k, o, total, seen, false, op);
+			});
+
+		return true;
+	}
+
+	template<class op_t>
+	std::vector<double> scan(const std::string& name, op_t&& op, size_t from = 0, size_t length = 0) const
+	{
+		std::vector<double> out;
+		this->scan(name, op, out, from, length);
+		return out;
+	}
 
-			if (!std::isnan(d1) && !std::isnan(d2))
-			{
-				vals.emplace_back(n_math::log_relative_change(d1, d2));
-			}
-		}
+	std::vector<double> diff(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		std::vector<double> out;
+		this->transform(name, e_transform::diff, out, from, length);
+		return out;
+	}
 
-		return vals;
+	bool diff(const std::string& name, std::vector<double>& out, size_t from = 0, size_t length = 0) const
+	{
+		return this->transform(name, e_transform::diff, out, from, length);
 	}
 
-	std::vector<double> cumsum(const std::string& name, size_t from = 0, size_t length = 0) const
+	std::vector<double> diff(const std::string& name1, const std::string& name2, size_t from = 0, size_t length = 0) const
 	{
-		if (name.empty())
+		if (name1.empty() || name2.empty())
 		{
 			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
 			return {};
 		}
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return {}; }
+		const c_column* col1 = this->_find_range(name1, from, length);
+		if (!col1) { return {}; }
+
+		const c_column* col2 = this->_find_range(name2, from, length);
+		if (!col2) { return {}; }
 
-		const auto& col = it->second;
+		return this->_gather(*col1, *col2, from, length, [](double d1, double d2) { return d1 - d2; });
+	}
 
-		const size_t n = col.size();
-		if (n == 0) { return {}; }
+	std::vector<double> pct_change(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		std::vector<double> out;
+		this->transform(name, e_transform::pct_change, out, from, length);
+		return out;
+	}
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return {}; }
+	bool pct_change(const std::string& name, std::vector<double>& out, size_t from = 0, size_t length = 0) const
+	{
+		return this->transform(name, e_transform::pct_change, out, from, length);
+	}
 
-		std::vector<double> vals;
-		vals.reserve(length);
-		for (size_t i = from; i < from + length; ++i)
+	std::vector<double> pct_change(const std::string& name1, const std::string& name2, size_t from = 0, size_t length = 0) const
+	{
+		if (name1.empty() || name2.empty())
 		{
-			double d = std::numeric_limits<double>::quiet_NaN();
+			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
+			return {};
+		}
 
-			if (std::holds_alternative<double>(col[i]))
-			{
-				d = std::get<double>(col[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
-			}
+		const c_column* col1 = this->_find_range(name1, from, length);
+		if (!col1) { return {}; }
 
-			if (!std::isnan(d))
-			{
-				vals.emplace_back(d);
-			}
-		}
+		const c_column* col2 = this->_find_range(name2, from, length);
+		if (!col2) { return {}; }
 
-		std::vector<double> cumsum;
-		cumsum.reserve(length);
-		cumsum.emplace_back(vals[0]);
-		for (size_t i = 1; i < vals.size(); ++i) { cumsum.emplace_back(cumsum.back() + vals[i]); }
+		return this->_gather(*col1, *col2, from, length, [](double d1, double d2) { return n_math::relative_change(d1, d2); });
+	}
 
-		return cumsum;
+	std::vector<double> log_change(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		std::vector<double> out;
+		this->transform(name, e_transform::log_change, out, from, length);
+		return out;
 	}
 
-	std::vector<double> cumprod(const std::string& name, size_t from = 0, size_t length = 0) const
+	bool log_change(const std::string& name, std::vector<double>& out, size_t from = 0, size_t length = 0) const
 	{
-		if (name.empty())
+		return this->transform(name, e_transform::log_change, out, from, length);
+	}
+
+	std::vector<double> log_change(const std::string& name1, const std::string& name2, size_t from = 0, size_t length = 0) const
+	{
+		if (name1.empty() || name2.empty())
 		{
 			c_logger::get().log("[c_dataframe]: No column name\n", LOG_CLR_RED);
 			return {};
 		}
 
-		auto it = this->m_data.find(name);
-		if (it == this->m_data.end()) { return {}; }
-
-		const auto& col = it->second;
-
-		const size_t n = col.size();
-		if (n == 0) { return {}; }
+		const c_column* col1 = this->_find_range(name1, from, length);
+		if (!col1) { return {}; }
 
-		if (length == 0 || from + length > n) { length = n - from; }
-		if (from >= n || length == 0) { return {}; }
+		const c_column* col2 = this->_find_range(name2, from, length);
+		if (!col2) { return {}; }
 
-		std::vector<double> vals;
-		vals.reserve(length);
-		for (size_t i = from; i < from + length; ++i)
-		{
-			double d = std::numeric_limits<double>::quiet_NaN();
+		return this->_gather(*col1, *col2, from, length, [](double d1, double d2) { return n_math::log_relative_change(d1, d2); });
+	}
 
-			if (std::holds_alternative<double>(col[i]))
-			{
-				d = std::get<double>(col[i]);
-			}
-			else
-			{
-				const std::string& s = std::get<std::string>(col[i]);
-				if (_is_blank(s)) { continue; }
-				auto parsed = _parse_double(s);
-				if (!parsed.has_value()) { continue; }
-				d = *parsed;
-			}
+	std::vector<double> cumsum(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		std::vector<double> out;
+		this->transform(name, e_transform::cumsum, out, from, length);
+		return out;
+	}
 
-			if (!std::isnan(d))
-			{
-				vals.emplace_back(d);
-			}
-		}
+	bool cumsum(const std::string& name, std::vector<double>& out, size_t from = 0, size_t length = 0) const
+	{
+		return this->transform(name, e_transform::cumsum, out, from, length);
+	}
 
-		std::vector<double> cumprod;
-		cumprod.reserve(length);
-		cumprod.emplace_back(vals[0]);
-		for (size_t i = 1; i < vals.size(); ++i) { cumprod.emplace_back(cumprod.back() * vals[i]); }
+	std::vector<double> cumprod(const std::string& name, size_t from = 0, size_t length = 0) const
+	{
+		std::vector<double> out;
+		this->transform(name, e_transform::cumprod, out, from, length);
+		return out;
+	}
 
-		return cumprod;
+	bool cumprod(const std::string& name, std::vector<double>& out, size_t from = 0, size_t length = 0) const
+	{
+		return this->transform(name, e_transform::cumprod, out, from, length);
 	}
 
 	void reset()
 	{
 		this->m_data.clear();
 		this->m_rows = 0;
+		this->m_start = 0;
+		this->m_dead_rows = 0;
+		this->m_dead.clear();
 	}
 
 	c_dataframe head(size_t n = 5) const
@@ -1628,17 +8245,7 @@ public:
 			return c_dataframe();
 		}
 
-		c_dataframe df;
-		size_t num = std::min(n, this->m_rows);
-
-		for (const auto& [name, col] : this->m_data)
-		{
-			std::vector<value_t> sub(col.begin(), col.begin() + num);
-			df.m_data.emplace(name, std::move(sub));
-		}
-
-		df.m_rows = num;
-		return df;
+		return this->_rows(0, std::min(n, this->m_rows));
 	}
 
 	c_dataframe tail(size_t n = 5) const
@@ -1649,16 +8256,90 @@ public:
 			return c_dataframe();
 		}
 
-		c_dataframe df;
-		size_t num = std::min(n, this->m_rows);
+		const size_t num = std::min(n, this->m_rows);
+		return this->_rows(this->m_rows - num, num);
+	}
 
-		for (const auto& [name, col] : this->m_data)
+	s_column_ref col(const std::string& name) const
+	{
+		return { this, name };
+	}
+
+	/*
+	*	bit i is set when live row i satisfies op against value, with the s_predicate rules. row blocks are compared in
+	*	parallel, double columns 4 (avx2) or 2 (sse2) values per instruction
+	*/
+	c_mask compare(const std::string& name, e_compare op, const value_t& value) const
+	{
+		auto it = this->m_data.find(name);
+		if (it == this->m_data.end())
+		{
+			c_logger::get().log("[c_dataframe]: No column name: " + name + "\n", LOG_CLR_RED);
+			return c_mask();
+		}
+
+		const c_column& column = it->second;
+		const s_predicate predicate{ name, op, value };
+		c_mask mask(this->m_rows);
+		uint64_t* words = mask.words();
+
+		const size_t blocks = (this->m_rows + _mask_block_rows - 1) / _mask_block_rows;
+		c_thread_pool::get().parallel_for(blocks, [&](size_t b) {
+			const size_t from = b * _mask_block_rows;
+			std::vector<uint64_t> bits;
+			size_t at = from;
+
+			this->_live_runs(from, std::min(_mask_block_rows, this->m_rows - from), [&](size_t p, size_t k) {
+				if (!(at & 63)) { _compare_rows(column, p, k, predicate, words + (at >> 6)); }
+				else
+				{
+					bits.resize((k + 63) / 64);
+					_compare_rows(column, p, k, predicate, bits.data());
+					_or_bits(words, at, bits.data(), k);
+				}
+				at += k;
+				});
+			});
+
+		return mask;
+	}
+
+	/*
+	*	new frame with the live rows whose mask bit is set; each column is gathered in one pass, in parallel across columns
+	*/
+	c_dataframe filter(const c_mask& mask) const
+	{
+		if (mask.size() != this->m_rows)
 		{
-			std::vector<value_t> sub(col.end() - num, col.end());
-			df.m_data.emplace(name, std::move(sub));
+			c_logger::get().log("[c_dataframe]: Mask length mismatch\n", LOG_CLR_RED);
+			return c_dataframe();
 		}
 
-		df.m_rows = num;
+		std::vector<std::pair<const std::string*, const c_column*>> columns;
+		for (const auto& [name, column] : this->m_data) { columns.emplace_back(&name, &column); }
+
+		const size_t count = mask.count();
+		std::vector<c_column> out(columns.size());
+
+		c_thread_pool::get().parallel_for(columns.size(), [&](size_t c) {
+			out[c] = columns[c].second->visit([&](const auto& v) {
+				using t = typename std::decay_t<decltype(v)>::value_type;
+				std::vector<t> kept;
+				kept.reserve(count);
+
+				size_t at = 0;
+				this->_live_runs(0, this->m_rows, [&](size_t p, size_t k) {
+					mask.for_each(at, at + k, [&](size_t i) { kept.push_back(v[p + i - at]); });
+					at += k;
+					});
+
+				return c_column(std::move(kept));
+				});
+			});
+
+		c_dataframe df;
+		for (size_t c = 0; c < columns.size(); ++c) { df.m_data.emplace(*columns[c].first, std::move(out[c])); }
+		df.m_rows = count;
 		return df;
 	}
 
@@ -1670,6 +8351,7 @@ public:
 			return;
 		}
 
+
 		c_logger::get().log_formatted("\t", LOG_CLR_NORMAL, 30);
 		for (const auto& [key, value] : this->m_data) { c_logger::get().log_formatted(key, LOG_CLR_YELLOW, 30); }
 		std::cout << std::endl << std::endl;
@@ -1677,10 +8359,11 @@ public:
 		size_t num = std::min(n, this->m_rows);
 		for (size_t i = 0; i < num; ++i)
 		{
+			const size_t row = this->_physical(i);
 			c_logger::get().log_formatted("\t" + std::to_string(i), LOG_CLR_YELLOW, 30);
 			for (const auto& [key, value] : this->m_data)
 			{
-				c_logger::get().log_formatted(_value_to_string(value[i]), LOG_CLR_NORMAL, 30);
+				c_logger::get().log_formatted(value.to_string(row), LOG_CLR_NORMAL, 30);
 			}
 			std::cout << std::endl;
 		}
@@ -1688,31 +8371,79 @@ public:
 	}
 };
 
-template<size_t n>
-inline value_t c_dataframe::_to_value(const char(&lit)[n])
-{
-	return value_t{ std::string(lit) };
-}
+inline c_mask operator==(const s_column_ref& ref, double value) { return ref.df->compare(ref.name, e_compare::eq, value); }
+inline c_mask operator!=(const s_column_ref& ref, double value) { return ref.df->compare(ref.name, e_compare::ne, value); }
+inline c_mask operator<(const s_column_ref& ref, double value) { return ref.df->compare(ref.name, e_compare::lt, value); }
+inline c_mask operator<=(const s_column_ref& ref, double value) { return ref.df->compare(ref.name, e_compare::le, value); }
+inline c_mask operator>(const s_column_ref& ref, double value) { return ref.df->compare(ref.name, e_compare::gt, value); }
+inline c_mask operator>=(const s_column_ref& ref, double value) { return ref.df->compare(ref.name, e_compare::ge, value); }
+
+inline c_mask operator==(const s_column_ref& ref, const std::string& value) { return ref.df->compare(ref.name, e_compare::eq, value); }
+inline c_mask operator!=(const s_column_ref& ref, const std::string& value) { return ref.df->compare(ref.name, e_compare::ne, value); }
+inline c_mask operator<(const s_column_ref& ref, const std::string& value) { return ref.df->compare(ref.name, e_compare::lt, value); }
+inline c_mask operator<=(const s_column_ref& ref, const std::string& value) { return ref.df->compare(ref.name, e_compare::le, value); }
+inline c_mask operator>(const s_column_ref& ref, const std::string& value) { return ref.df->compare(ref.name, e_compare::gt, value); }
+inline c_mask operator>=(const s_column_ref& ref, const std::string& value) { return ref.df->compare(ref.name, e_compare::ge, value); }
 
 template<class t>
-std::vector<value_t> c_dataframe::_to_column(const std::vector<t>& v)
+c_column c_dataframe::_to_column(const std::vector<t>& v)
 {
-	std::vector<value_t> out;
-	out.reserve(v.size());
-	for (const auto& x : v) { out.push_back(_to_value(x)); }
-	return out;
+	if constexpr (std::is_same_v<t, value_t>)
+	{
+		return _to_column(v);
+	}
+	else if constexpr (std::is_same_v<t, bool>)
+	{
+		std::vector<uint8_t> out(v.size());
+		for (size_t i = 0; i < v.size(); ++i) { out[i] = v[i] ? 1 : 0; }
+		return c_column(std::move(out));
+	}
+	else if constexpr (std::is_floating_point_v<t>)
+	{
+		return c_column(std::vector<double>(v.begin(), v.end()));
+	}
+	else if constexpr (std::is_integral_v<t>)
+	{
+		return c_column(std::vector<int64_t>(v.begin(), v.end()));
+	}
+	else if constexpr (std::is_constructible_v<std::string, const t&>)
+	{
+		std::vector<std::string> out;
+		out.reserve(v.size());
+		for (const auto& x : v)
+		{
+			if constexpr (std::is_pointer_v<t>) { out.emplace_back(x ? x : ""); }
+			else { out.emplace_back(x); }
+		}
+		return c_column(std::move(out));
+	}
+	else
+	{
+		static_assert(!sizeof(t), "c_dataframe::add_column<T>: unsupported T");
+	}
 }
 
 template<class t>
-std::vector<value_t> c_dataframe::_to_column(std::vector<t>&& v)
+c_column c_dataframe::_to_column(std::vector<t>&& v)
 {
-	std::vector<value_t> out;
-	out.reserve(v.size());
-	for (auto& x : v) { out.push_back(_to_value(std::move(x))); }
-	return out;
+	if constexpr (std::is_same_v<t, double>)
+	{
+		return c_column(std::move(v));
+	}
+	else if constexpr (std::is_same_v<t, int64_t>)
+	{
+		return c_column(std::move(v));
+	}
+	else if constexpr (std::is_same_v<t, std::string>)
+	{
+		return c_column(std::move(v));
+	}
+	else
+	{
+		return _to_column(static_cast<const std::vector<t>&>(v));
+	}
 }
 
-
 template<class t>
 bool c_dataframe::add_column(const std::string& name, const std::vector<t>& values)
 {
@@ -1728,19 +8459,23 @@ bool c_dataframe::add_column(const std::string& name, std::vector<t>&& values)
 template<typename t>
 std::vector<t> c_dataframe::at(const std::string& name)
 {
+	this->compact();
+
 	const auto& col = this->m_data.at(name);
 	std::vector<t> out;
 	out.reserve(col.size());
 
-	if (std::holds_alternative<double>(col[0]))
+	if (col.is_numeric())
 	{
-		if constexpr (std::is_same_v<t, double>)
+		if constexpr (std::is_same_v<t, double> || std::is_integral_v<t>)
 		{
-			for (const auto& v : col) { out.push_back(std::get<double>(v)); }
-		}
-		else if constexpr (std::is_integral_v<t> || std::is_same_v<t, bool>)
-		{
-			for (const auto& v : col) { out.push_back(static_cast<t>(std::get<double>(v))); }
+			col.visit([&](const auto& v) {
+				using v_t = typename std::decay_t<decltype(v)>::value_type;
+				if constexpr (!std::is_same_v<v_t, std::string>)
+				{
+					for (const auto& x : v) { out.push_back(static_cast<t>(x)); }
+				}
+				});
 		}
 		else
 		{
@@ -1750,32 +8485,22 @@ std::vector<t> c_dataframe::at(const std::string& name)
 		return out;
 	}
 
+	const auto& strs = col.values<std::string>();
+
 	if constexpr (std::is_same_v<t, std::string>)
 	{
-		for (const auto& v : col) { out.push_back(std::get<std::string>(v)); }
-		return out;
+		return strs;
 	}
 	else if constexpr (std::is_same_v<t, double>)
 	{
-		for (const auto& v : col)
-		{
-			const auto& s = std::get<std::string>(v);
-			if (_is_blank(s))
-			{
-				out.push_back(std::numeric_limits<double>::quiet_NaN());
-				continue;
-			}
-			auto parsed = _parse_double(s);
-			out.push_back(parsed.value_or(std::numeric_limits<double>::quiet_NaN()));
-		}
+		for (const auto& s : strs) { out.push_back(_to_double(s)); }
 		return out;
 	}
-	else if constexpr (std::is_integral_v<t> || std::is_same_v<t, bool>)
+	else if constexpr (std::is_integral_v<t>)
 	{
-		for (const auto& v : col)
+		for (const auto& s : strs)
 		{
-			const auto& s = std::get<std::string>(v);
-			auto parsed = _parse_double(s);
+			auto parsed = c_column::parse_double(s);
 			if (parsed.has_value() && std::isfinite(*parsed)) { out.push_back(static_cast<t>(*parsed)); }
 			else { throw std::runtime_error("c_dataframe::at<T>: non-parsable string to integer"); }
 		}
@@ -1802,4 +8527,222 @@ inline std::vector<std::vector<t>> c_dataframe::at(const std::vector<std::string
 	}
 
 	return out;
-}
\ No newline at end of file
+}
+
+/*
+*	reads a csv file in batches of at most batch_rows rows; only the bytes of the current batch are buffered and the batch
+*	frame's column buffers are reused between calls to next()
+*/
+class c_csv_reader
+{
+private:
+
+	static constexpr size_t _min_buffer = size_t(1) << 20;
+
+	std::ifstream m_file;
+	s_csv_options m_options;
+	size_t m_batch_rows = 0;
+	size_t m_rows = 0;
+	size_t m_records = 0;
+
+	std::vector<char> m_buffer;
+	size_t m_begin = 0;
+	size_t m_end = 0;
+	bool m_eof = false;
+	bool m_open = false;
+
+	std::vector<std::string> m_names;
+	std::vector<e_dtype> m_types;
+	std::vector<uint8_t> m_forced;
+	c_dataframe::s_csv_plan m_plan;
+
+	bool _fill()
+	{
+		if (this->m_eof) { return false; }
+
+		if (this->m_begin)
+		{
+			std::memmove(this->m_buffer.data(), this->m_buffer.data() + this->m_begin, this->m_end - this->m_begin);
+			this->m_end -= this->m_begin;
+			this->m_begin = 0;
+		}
+
+		if (this->m_end == this->m_buffer.size()) { this->m_buffer.resize(std::max(_min_buffer, this->m_buffer.size() * 2)); }
+
+		this->m_file.read(this->m_buffer.data() + this->m_end, static_cast<std::streamsize>(this->m_buffer.size() - this->m_end));
+		const size_t got = static_cast<size_t>(this->m_file.gcount());
+		this->m_end += got;
+
+		if (!this->m_file) { this->m_eof = true; }
+
+		return got != 0;
+	}
+
+	/*
+	*	buffers up to n complete records (or the rest of the file) and returns their end
+	*/
+	const char* _buffer_records(size_t n, size_t& records)
+	{
+		while (true)
+		{
+			const char* b = this->m_buffer.data() + this->m_begin;
+			const char* e = this->m_buffer.data() + this->m_end;
+
+			const char* last = c_dataframe::_seek_csv_records(b, e, n, records);
+			if (records == n) { return last; }
+
+			if (this->m_eof)
+			{
+				records = c_dataframe::_count_csv_records(b, e);
+				return e;
+			}
+
+			this->_fill();
+		}
+	}
+
+public:
+
+	explicit c_csv_reader(const std::string& csv_path, size_t batch_rows = 65536, const s_csv_options& options = {})
+		: m_file(csv_path, std::ios::in | std::ios::binary), m_options(options), m_batch_rows(std::max<size_t>(1, batch_rows))
+	{
+		if (!this->m_file.is_open()) { return; }
+
+		this->m_open = true;
+
+		if (this->m_options.header)
+		{
+			size_t records = 0;
+			const char* e = this->_buffer_records(1, records);
+			const char* b = this->m_buffer.data() + this->m_begin;
+
+			std::string scratch;
+			c_dataframe::_tokenize_csv(b, e, scratch, [&](size_t, std::string_view sv) { this->m_names.emplace_back(sv); }, []() { return false; });
+			this->m_begin = static_cast<size_t>(e - this->m_buffer.data());
+		}
+
+		if (!c_dataframe::_plan_csv(this->m_names, this->m_options, this->m_plan))
+		{
+			this->m_open = false;
+			return;
+		}
+
+		for (size_t skip = this->m_options.skiprows; skip > 0;)
+		{
+			size_t records = 0;
+			const char* e = this->_buffer_records(std::min(skip, this->m_batch_rows), records);
+			if (!records) { break; }
+
+			this->m_begin = static_cast<size_t>(e - this->m_buffer.data());
+			skip -= records;
+		}
+	}
+
+	bool is_open() const noexcept
+	{
+		return this->m_open;
+	}
+
+	const std::vector<std::string>& columns() const noexcept
+	{
+		return this->m_names;
+	}
+
+	size_t rows_read() const noexcept
+	{
+		return this->m_rows;
+	}
+
+	/*
+	*	fills batch with the next rows and returns false once the file is exhausted. column types are inferred from the first
+	*	batch (infer_rows 0 samples all of it) and stay fixed afterwards unless a later field forces a column wider. batches
+	*	cover batch_rows records of the file, so with predicates they may hold fewer rows; fully filtered batches are skipped
+	*/
+	bool next(c_dataframe& batch)
+	{
+		if (!this->m_open) { return false; }
+
+		while (true)
+		{
+			size_t wanted = this->m_batch_rows;
+			if (this->m_options.nrows)
+			{
+				if (this->m_records >= this->m_options.nrows) { return false; }
+				wanted = std::min(wanted, this->m_options.nrows - this->m_records);
+			}
+
+			size_t records = 0;
+			const char* e = this->_buffer_records(wanted, records);
+			const char* b = this->m_buffer.data() + this->m_begin;
+			if (!records) { return false; }
+
+			if (this->m_types.empty())
+			{
+				std::vector<c_dataframe::s_dtype_inference> inference(this->m_names.size());
+				c_dataframe::_infer_csv_sample(b, e, this->m_options, this->m_plan, inference);
+
+				for (size_t i = this->m_names.size(); i < inference.size(); ++i) { this->m_names.push_back("col_" + std::to_string(i)); }
+
+				if (!c_dataframe::_check_csv_plan(this->m_names, this->m_plan))
+				{
+					this->m_open = false;
+					return false;
+				}
+
+				for (size_t i = 0; i < this->m_names.size(); ++i)
+				{
+					auto it = this->m_options.schema.find(this->m_names[i]);
+					this->m_forced.push_back(it != this->m_options.schema.end());
+					this->m_types.push_back(this->m_forced.back() ? it->second : inference[i].type());
+				}
+
+				if (this->m_types.empty()) { return false; }
+			}
+
+			std::vector<c_dataframe::s_csv_chunk> chunks = c_dataframe::_split_csv(b, e);
+			c_thread_pool::get().parallel_for(chunks.size(), [&](size_t c) {
+				chunks[c].rows = c_dataframe::_count_csv_records(chunks[c].begin, chunks[c].end);
+				});
+			c_dataframe::_filter_csv_chunks(chunks, this->m_plan);
+
+			this->m_begin = static_cast<size_t>(e - this->m_buffer.data());
+			this->m_records += records;
+
+			size_t rows = 0;
+			for (const auto& chunk : chunks) { rows += chunk.rows; }
+			if (!rows) { continue; }
+
+			std::vector<c_column> columns(this->m_names.size());
+			for (size_t i = 0; i < this->m_names.size(); ++i)
+			{
+				if (!this->m_plan.is_selected(i)) { continue; }
+
+				auto it = batch.m_data.find(this->m_names[i]);
+				if (it != batch.m_data.end() && it->second.type() == this->m_types[i]) { columns[i] = std::move(it->second); }
+				else { columns[i] = c_column(this->m_types[i]); }
+
+				columns[i].visit([rows](auto& v) { v.resize(rows); });
+			}
+
+			batch.reset();
+
+			if (!c_dataframe::_parse_csv_chunks(chunks, columns, this->m_names, this->m_forced, this->m_plan))
+			{
+				this->m_open = false;
+				return false;
+			}
+
+			for (size_t i = 0; i < columns.size(); ++i)
+			{
+				if (!this->m_plan.is_selected(i)) { continue; }
+
+				this->m_types[i] = columns[i].type();
+				batch.m_data.emplace(this->m_names[i], std::move(columns[i]));
+			}
+			batch.m_rows = rows;
+			this->m_rows += rows;
+
+			return true;
+		}
+	}
+};
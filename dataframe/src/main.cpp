@@ -11,6 +11,7 @@ int main()
 	std::vector<double> data_double = { 1.0, 2.0, 3.0, 4.0, 5.0 };
 	std::vector<std::string> data_string = { "one", "two", "three", "four", "five" };
 	std::vector<std::string> column_names = { "ex_data_string", "im_data_string" };
+	std::vector<double> buffer;
 
 	/*
 	*	HOW TO USE
@@ -38,19 +39,42 @@ int main()
 	df.dropf();																// drops first row in the dataframe
 	df.dropb();																// drops last row in the dataframe
 	df.drop(3);																// drops the third row in the dataframe
+	df.compact();															// erases dropped rows from the column buffers (done automatically once they outnumber live rows)
+	df.append(df.head(2));													// appends the rows of a dataframe with the same columns
 	df.dropna();															// drops all rows where NaN (not a number) value is present
 	df.dropinf();															// drops all rows where INF (infinite) value is present
 	df.dropemp();															// drops all rows where some value is empty
+	c_dataframe df_filtered = df.filter((df.col("ex_data_int") > 3.0) & (df.col("ex_data_string") != ""));	// new dataframe with the rows where "ex_data_int" > 3 and "ex_data_string" is not empty
 
 	df.at<double>("im_data_double");										// gets values from "im_data_double" column as vector<double>
 			
 	df.at<std::string>(column_names);										// gets values from multiple columns "column_names" as vector<vector<std::string>>
+	df.at("im_data_double").version();										// version of the "im_data_double" column, bumped by every modification; cached statistics are reused until it changes
 
 	df.from_csv("sample2.csv");												// loads existing "sample.csv" into dataframe
 	df.from_csv("sample2.csv", false);										// loads existing "sample.csv" into dataframe without headers
+	s_csv_options csv_options;												// options for loading csv files
+	csv_options.infer_rows = 100;											// infers column types (int64 / double / string) from the first 100 rows
+	csv_options.schema["price"] = e_dtype::f64;								// forces column "price" to be parsed as double instead of inferring it
+	csv_options.usecols = { "price", "volume" };							// loads only columns "price" and "volume", other fields are never parsed
+	csv_options.skiprows = 10; csv_options.nrows = 1000;					// skips the first 10 data rows and reads the next 1000
+	csv_options.where.push_back({ "volume", e_compare::gt, 0.0 });			// keeps only rows where "volume" > 0, filtered while parsing
+	c_dataframe df_typed("sample2.csv", csv_options);						// loads existing "sample2.csv" with typed columns parsed once at load time
+	c_csv_reader reader("huge.csv", 100000);								// streams "huge.csv" in batches of 100000 rows without loading the whole file
+	c_dataframe batch;														// batch frame, its column buffers are reused between batches
+	while (reader.next(batch)) { batch.sum("ex_data_int"); }				// reads the next batch into "batch" until the file is exhausted
 	
 	df.to_csv("output.csv");												// saves dataframe to "outputs.csv"
 	df.to_csv("output.csv", false);											// saves dataframe to "outputs.csv" without headers
+	df.to_csv("output.csv", true, false);									// saves dataframe to "outputs.csv", formatting rows on the calling thread only
+	df.save("output.dfc");													// saves dataframe to "output.dfc" in the binary columnar format
+	c_dataframe df_loaded; df_loaded.load("output.dfc");					// maps "output.dfc", numeric columns are used in place without parsing or copying
+	df.to_arrow("output.feather");											// saves dataframe to "output.feather" as an Arrow IPC file (Feather v2)
+	c_dataframe df_arrow; df_arrow.from_arrow("output.feather");			// loads an Arrow IPC file, int64 / double buffers are used in place when possible
+	df.to_parquet("output.parquet");										// saves dataframe to "output.parquet", snappy compressed, in row groups of 1M rows
+	s_parquet_options parquet_options; parquet_options.usecols = { "ex_data_int" };	// reads only the "ex_data_int" column chunks
+	parquet_options.where.push_back({ "ex_data_int", e_compare::ge, 10.0 });	// skips row groups whose statistics rule out "ex_data_int" >= 10
+	c_dataframe df_parquet; df_parquet.from_parquet("output.parquet", parquet_options);	// loads the selected columns of the matching rows of "output.parquet"
 
 	auto shape = df.shape();												// returns pair {number of rows, number of columns} in the dataframe
 
@@ -75,11 +99,15 @@ int main()
 	df.max("ex_data_int");													// returns the maximum value in the "ex_data_int" column
 	df.max("ex_data_int", 2, 5);											// returns the maximum value in the "ex_data_int" column from index 2 to index 5
 
+	df.mean(std::vector<std::string>{ "ex_data_int", "im_data_double" });	// returns the mean of each listed column as vector<double>, the columns reduced together (also sum, var, std, min, max)
+
 	df.cov("ex_data_int", "im_data_double");								// calculates the covariance between columns "ex_data_int" and "im_data_double"
 	df.cov("ex_data_int", "im_data_double", 2, 5);							// calculates the covariance between columns "ex_data_int" and "im_data_double" from index 2 to index 5
 
 	df.corr("ex_data_int", "im_data_double");								// calculates the correlation between columns "ex_data_int" and "im_data_double"
 	df.corr("ex_data_int", "im_data_double", 2, 5);							// calculates the correlation between columns "ex_data_int" and "im_data_double" from index 2 to index 5
+	df.cov_matrix({ "ex_data_int", "im_data_double" });						// covariance matrix of the columns as a dataframe, rows labeled in its "column" column
+	df.corr_matrix();														// correlation matrix of every numeric column
 
 	df.skew("ex_data_int");													// returns the skewness of all values in the "ex_data_int" column
 	df.skew("ex_data_int", 2, 5);											// returns the skewness of values in the "ex_data_int" column from index 2 to index 5
@@ -87,6 +115,21 @@ int main()
 	df.kurt("ex_data_int");													// returns the kurtosis of all values in the "ex_data_int" column
 	df.kurt("ex_data_int", 2, 5);											// returns the kurtosis of values in the "ex_data_int" column from index 2 to index 5
 
+	df.median("ex_data_int");												// returns the median of the "ex_data_int" column (exact, O(n) selection)
+	df.quantile("ex_data_int", 0.9, 2, 5);									// returns the 0.9 quantile of values from index 2 to index 5, linearly interpolated
+	df.quantile("ex_data_int", { 0.25, 0.5, 0.75 });						// returns several exact quantiles from one copy and one selection pass
+	df.sketch("ex_data_int").quantile(0.99);								// approximate quantile from a mergeable t-digest (c_tdigest) built in parallel; add() / merge() keep it current
+
+	df.describe("ex_data_int");												// returns an s_stats with count, sum, mean, var, std, min, max, skew and kurt of the "ex_data_int" column in one pass
+	df.describe("ex_data_int", 2, 5);										// returns the same statistics for the values from index 2 to index 5
+	df.describe();															// returns a dataframe with one row per statistic and one column per numeric column
+
+	df.rolling("ex_data_int", 3).mean();									// mean of each trailing window of 3 rows of "ex_data_int" as vector<double>, NaN until the window is full
+	df.rolling("ex_data_int", 3, 1).max();									// max of each trailing window of 3 rows, from the first row with a value (min_periods 1)
+
+	df.build_index("ex_data_int");											// opt-in range index: sum, mean, var, std, min and max of "ex_data_int" over any range in O(1), kept by append
+	df.drop_index("ex_data_int");											// frees the range index of "ex_data_int"
+
 	df.diff("ex_data_int");													// returns differences between each value in "ex_data_int" column as vector<double>
 	df.diff("ex_data_int", 2, 5);											// returns differences between each value in "ex_data_int" column from index 2 to index 5 as vector<double>
 
@@ -102,6 +145,10 @@ int main()
 	df.cumprod("ex_data_int");												// returns cumulative multiplication product of values in "ex_data_int" column as vector<double>
 	df.cumprod("ex_data_int", 2, 5);										// returns cumulative multiplication product of values in "ex_data_int" column from index 2 to index 5 as vector<double>
 
+	df.cumsum("ex_data_int", buffer);										// writes the cumulative sum into a reused vector<double> buffer, no allocation once it has the capacity
+	df.transform("ex_data_int", e_transform::pct_change, "ex_returns");		// writes the percent change straight into the rows of a new or existing double column "ex_returns"
+	df.scan("ex_data_int", [](double a, double b) { return std::max(a, b); });	// running max of "ex_data_int" as vector<double>: inclusive scan with any associative op, in parallel blocks
+
 	df.reset();																// clears and resets the dataframe
 
 	df.head();																// takes the top 5 rows of the dataframe and creates a new dataframe with those values